@@ -0,0 +1,260 @@
+/*
+ * driver.cpp
+ *
+ * Standalone benchmark driver: links the classes of src/ directly and times the
+ * construction, evaluation, CDF/quantile, sampling, MFPS and printing phases over
+ * a grid of distribution types, finitization orders and parameters. R is embedded
+ * only because the classes allocate R vectors and use R's RNG; no R code runs in
+ * the timed sections.
+ *
+ * Usage: driver [--n-max N] [--reps R] [--draws D] [--threads T] [--print-max-n P]
+ *               [--seed S] [--format csv|json] [--out FILE]
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include <Rcpp.h>
+#include <Rembedded.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/Finitization.h"
+#include "../src/FinitizationCache.h"
+#include "../src/DistributionType.h"
+#include "../src/EvaluationEngine.h"
+#include "../src/MfpsSolver.h"
+#include "../src/SamplerType.h"
+
+using namespace std;
+
+struct Options {
+    int nMax = 60;
+    int reps = 5;
+    int draws = 1000000;
+    int threads = 1;
+    int printMaxN = 20;
+    int seed = 20261017;
+    string format = "csv";
+    string out;
+};
+
+struct Result {
+    string dtype;
+    int n;
+    double theta;
+    int size;
+    string metric;
+    double value;
+    string unit;
+};
+
+// One point of the benchmark grid
+struct Case {
+    string dtype;
+    DistributionKey key;
+};
+
+typedef chrono::steady_clock Clock;
+
+static double since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Median of the times of reps runs of f, each preceded by an untimed call of setup
+template<typename S, typename F>
+static double medianTime(int reps, S setup, F f) {
+    vector<double> times;
+    for (int r = 0; r < reps; ++r) {
+        setup();
+        const Clock::time_point start = Clock::now();
+        f();
+        times.push_back(since(start));
+    }
+    sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+template<typename F>
+static double medianTime(int reps, F f) {
+    return medianTime(reps, []() {}, f);
+}
+
+// Drops the cached distributions, templates and kernels, so that a construction starts from scratch
+static void clearCache() {
+    FinitizationCache::instance().clear();
+}
+
+static unique_ptr<Finitization> build(const DistributionKey& key, int engine) {
+    Finitization::setEngine(engine);
+    unique_ptr<Finitization> f = newFinitization(key);
+    Finitization::setEngine(EvaluationEngine::AUTO);
+    return f;
+}
+
+static vector<Case> grid(int nMax) {
+    const int orders[] = { 1, 2, 3, 5, 10, 20, 30, 40, 50, 60 };
+    vector<Case> cases;
+    for (int n : orders) {
+        if (n > nMax)
+            break;
+        cases.push_back({ "poisson", DistributionKey(DistributionType::POISSON, n, 0.5) });
+        for (int N : { 10, 100, 1000 })
+            cases.push_back({ "binomial", DistributionKey(DistributionType::BINOMIAL, n, 0.05, N) });
+        for (int k : { 1, 5 })
+            cases.push_back({ "negbinom", DistributionKey(DistributionType::NEGATIVEBINOMIAL, n, 0.2, k) });
+        cases.push_back({ "log", DistributionKey(DistributionType::LOGARITHMIC, n, 0.1) });
+    }
+    return cases;
+}
+
+static void runCase(const Case& c, const Options& opt, vector<Result>& results) {
+    const DistributionKey& key = c.key;
+    const int n = key.n;
+    auto add = [&](const string& metric, double value, const string& unit) {
+        results.push_back({ c.dtype, n, key.theta, key.size, metric, value, unit });
+    };
+
+    // Construction: series expansion, probabilities and sampling tables, from an empty cache and
+    // then reusing the template and kernel of the family left by the previous construction
+    double t = medianTime(opt.reps, clearCache, [&]() { build(key, EvaluationEngine::AUTO); });
+    add("construct", t, "s");
+    t = medianTime(opt.reps, [&]() { build(key, EvaluationEngine::AUTO); });
+    add("construct_warm", t, "s");
+
+    unique_ptr<Finitization> f = build(key, EvaluationEngine::AUTO);
+
+    // Evaluation of the PMF over the whole support
+    volatile double sink = 0.0;
+    const int sweeps = max(1, 100000 / (n + 1));
+    t = medianTime(opt.reps, [&]() {
+        for (int s = 0; s < sweeps; ++s)
+            for (int x = 0; x <= n; ++x)
+                sink = sink + f->fin_pdf(x);
+    });
+    add("fin_pdf", t / (sweeps * (n + 1.0)), "s/value");
+
+    // CDF and quantiles
+    const int queries = 100000;
+    t = medianTime(opt.reps, [&]() {
+        for (int q = 0; q < queries; ++q)
+            sink = sink + f->cdf(q % (n + 1));
+    });
+    add("cdf", t / queries, "s/value");
+    t = medianTime(opt.reps, [&]() {
+        for (int q = 0; q < queries; ++q)
+            sink = sink + f->quantile((q + 0.5) / queries);
+    });
+    add("quantile", t / queries, "s/value");
+
+    // Sampling throughput with the R generator and with the parallel streams
+    t = medianTime(opt.reps, [&]() { f->rvalues(opt.draws, SamplerType::AUTO); });
+    add("rvalues", opt.draws / t, "draws/s");
+    t = medianTime(opt.reps, [&]() { f->rvalues(opt.draws, opt.threads, SamplerType::AUTO); });
+    add("rvalues_streams", opt.draws / t, "draws/s");
+
+    // Maximum feasible parameter space
+    double lower, upper;
+    t = medianTime(opt.reps, [&]() { MfpsSolver().solve(*f, lower, upper); });
+    add("mfps", t, "s");
+
+    // Symbolic construction and printing, which grow quickly with n
+    if (n <= opt.printMaxN) {
+        t = medianTime(opt.reps, clearCache, [&]() { build(key, EvaluationEngine::SYMBOLIC); });
+        add("construct_symbolic", t, "s");
+        t = medianTime(opt.reps, [&]() {
+            unique_ptr<Finitization> g = newFinitization(key);
+            for (int x = 0; x <= n; ++x)
+                g->pdfToString(x, false);
+        });
+        add("print", t, "s");
+    }
+}
+
+static void writeCsv(ostream& os, const vector<Result>& results) {
+    os << "dtype,n,theta,size,metric,value,unit\n";
+    os.precision(10);
+    for (const Result& r : results)
+        os << r.dtype << ',' << r.n << ',' << r.theta << ',' << r.size << ',' << r.metric << ','
+           << r.value << ',' << r.unit << '\n';
+}
+
+static void writeJson(ostream& os, const vector<Result>& results) {
+    os.precision(10);
+    os << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << "  {\"dtype\": \"" << r.dtype << "\", \"n\": " << r.n << ", \"theta\": " << r.theta
+           << ", \"size\": " << r.size << ", \"metric\": \"" << r.metric << "\", \"value\": " << r.value
+           << ", \"unit\": \"" << r.unit << "\"}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "]\n";
+}
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Missing value for " << arg << endl;
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--n-max") opt.nMax = atoi(value);
+        else if (arg == "--reps") opt.reps = max(1, atoi(value));
+        else if (arg == "--draws") opt.draws = max(1, atoi(value));
+        else if (arg == "--threads") opt.threads = atoi(value);
+        else if (arg == "--print-max-n") opt.printMaxN = atoi(value);
+        else if (arg == "--seed") opt.seed = atoi(value);
+        else if (arg == "--format") opt.format = value;
+        else if (arg == "--out") opt.out = value;
+        else {
+            cerr << "Unknown option " << arg << endl;
+            return false;
+        }
+    }
+    if (opt.format != "csv" && opt.format != "json") {
+        cerr << "--format should be csv or json" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+        return 1;
+
+    const char* rargs[] = { "driver", "--vanilla", "--silent", "--no-echo" };
+    Rf_initEmbeddedR(sizeof(rargs) / sizeof(rargs[0]), const_cast<char**>(rargs));
+    // The Rcpp API resolves its entry points from the loaded Rcpp namespace
+    Rf_eval(Rf_lang2(Rf_install("loadNamespace"), Rf_mkString("Rcpp")), R_GlobalEnv);
+
+    vector<Result> results;
+    try {
+        Rcpp::Function("set.seed")(opt.seed);
+        for (const Case& c : grid(opt.nMax)) {
+            cerr << c.dtype << " n=" << c.key.n << " size=" << c.key.size << endl;
+            runCase(c, opt, results);
+        }
+    } catch (std::exception& e) {
+        cerr << "Benchmark failed: " << e.what() << endl;
+        Rf_endEmbeddedR(0);
+        return 1;
+    }
+
+    if (opt.out.empty()) {
+        opt.format == "csv" ? writeCsv(cout, results) : writeJson(cout, results);
+    } else {
+        ofstream os(opt.out.c_str());
+        opt.format == "csv" ? writeCsv(os, results) : writeJson(os, results);
+    }
+
+    Rf_endEmbeddedR(0);
+    return 0;
+}
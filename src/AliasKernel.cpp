@@ -0,0 +1,111 @@
+/*
+ * AliasKernel.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "AliasKernel.h"
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FINITIZATION_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+static void sampleScalar(const double* u, int count, int K, const double* cutoff, const int* alias, int* out) {
+    const double Kd = static_cast<double>(K);
+    const uint32_t last = static_cast<uint32_t>(K - 1);
+    for (int i = 0; i < count; ++i) {
+        const double uK = u[i] * Kd;
+        uint32_t j = (uint32_t)uK;          // floor for uK >= 0
+        if (j > last)                       // uK may round up to K
+            j = last;
+        const double f = uK - (double)j;
+        out[i] = (f < cutoff[j]) ? (int)j : alias[j];
+    }
+}
+
+#ifdef FINITIZATION_X86_KERNELS
+
+__attribute__((target("avx2")))
+static void sampleAvx2(const double* u, int count, int K, const double* cutoff, const int* alias, int* out) {
+    const __m256d vK = _mm256_set1_pd(static_cast<double>(K));
+    const __m128i vLast = _mm_set1_epi32(K - 1);
+    // Picks the low halves of the four 64-bit compare masks
+    const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d uK = _mm256_mul_pd(_mm256_loadu_pd(u + i), vK);
+        const __m128i j  = _mm_min_epi32(_mm256_cvttpd_epi32(uK), vLast);
+        const __m256d f  = _mm256_sub_pd(uK, _mm256_cvtepi32_pd(j));
+        const __m256d c  = _mm256_i32gather_pd(cutoff, j, 8);
+        const __m128i a  = _mm_i32gather_epi32(alias, j, 4);
+        const __m256i lt = _mm256_castpd_si256(_mm256_cmp_pd(f, c, _CMP_LT_OQ));
+        const __m128i m  = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(lt, pack));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_blendv_epi8(a, j, m));
+    }
+    sampleScalar(u + i, count - i, K, cutoff, alias, out + i);
+}
+
+__attribute__((target("avx512f,avx512vl")))
+static void sampleAvx512(const double* u, int count, int K, const double* cutoff, const int* alias, int* out) {
+    const __m512d vK = _mm512_set1_pd(static_cast<double>(K));
+    const __m256i vLast = _mm256_set1_epi32(K - 1);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d uK = _mm512_mul_pd(_mm512_loadu_pd(u + i), vK);
+        const __m256i j  = _mm256_min_epi32(_mm512_cvttpd_epi32(uK), vLast);
+        const __m512d f  = _mm512_sub_pd(uK, _mm512_cvtepi32_pd(j));
+        const __m512d c  = _mm512_i32gather_pd(j, cutoff, 8);
+        const __m256i a  = _mm256_i32gather_epi32(alias, j, 4);
+        const __mmask8 lt = _mm512_cmp_pd_mask(f, c, _CMP_LT_OQ);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mask_blend_epi32(lt, a, j));
+    }
+    sampleScalar(u + i, count - i, K, cutoff, alias, out + i);
+}
+
+#endif
+
+const int AliasKernel::BUFFER;
+int AliasKernel::s_kernel = AliasKernel::detect();
+
+void AliasKernel::sample(const double* u, int count, int K, const double* cutoff, const int* alias, int* out) {
+#ifdef FINITIZATION_X86_KERNELS
+    switch (s_kernel) {
+    case AVX512:
+        sampleAvx512(u, count, K, cutoff, alias, out);
+        return;
+    case AVX2:
+        sampleAvx2(u, count, K, cutoff, alias, out);
+        return;
+    default:
+        break;
+    }
+#endif
+    sampleScalar(u, count, K, cutoff, alias, out);
+}
+
+int AliasKernel::detect() {
+#ifdef FINITIZATION_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+        return AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2;
+#endif
+    return SCALAR;
+}
+
+int AliasKernel::select(int kernel) {
+    const int previous = s_kernel;
+    const int best = detect();
+    s_kernel = (kernel < 0 || kernel > best) ? best : kernel;
+    return previous;
+}
+
+int AliasKernel::selected() {
+    return s_kernel;
+}
@@ -0,0 +1,74 @@
+/*
+ * AliasKernel.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef ALIASKERNEL_H_
+#define ALIASKERNEL_H_
+
+/**
+ * @class AliasKernel
+ * @brief Vectorized kernels turning uniforms into alias-method draws.
+ *
+ * For each uniform u, the kernels compute uK = u * K, the bucket j = floor(uK)
+ * (at most K - 1), the fraction f = uK - j and return j if f < cutoff[j] and
+ * alias[j] otherwise. The AVX2 and AVX-512 kernels do the same IEEE operations
+ * as the scalar one, with gathers from the alias tables and a masked blend, so
+ * all the kernels give identical results for the same uniforms.
+ *
+ * The kernel is chosen at run time from the features of the CPU; the scalar
+ * kernel is used on other architectures and compilers.
+ */
+class AliasKernel {
+
+public:
+    // Portable scalar loop
+    static const int SCALAR = 0;
+
+    // 4 lanes, AVX2 gathers
+    static const int AVX2 = 1;
+
+    // 8 lanes, AVX-512F/VL gathers and mask registers
+    static const int AVX512 = 2;
+
+    static const int BUFFER = 256;   ///< Number of uniforms generated per call of sample()
+
+    /**
+     * @brief Fills \p out with the draws corresponding to the uniforms \p u.
+     *
+     * @param u The uniforms, in [0, 1).
+     * @param count The number of uniforms.
+     * @param K The number of support points.
+     * @param cutoff The probability table of the alias method.
+     * @param alias The alias table of the alias method.
+     * @param out The output array of \p count values.
+     */
+    static void sample(const double* u, int count, int K, const double* cutoff, const int* alias, int* out);
+
+    /**
+     * @brief Returns the best kernel supported by the CPU.
+     */
+    static int detect();
+
+    /**
+     * @brief Selects the kernel used by sample().
+     *
+     * A kernel not supported by the CPU is replaced by the best supported one
+     * that is not wider; a negative value selects detect().
+     *
+     * @return The kernel previously in use.
+     */
+    static int select(int kernel);
+
+    /**
+     * @brief Returns the kernel used by sample().
+     */
+    static int selected();
+
+private:
+    static int s_kernel;
+};
+
+#endif /* ALIASKERNEL_H_ */
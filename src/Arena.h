@@ -0,0 +1,131 @@
+/*
+ * Arena.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Arena
+ * @brief A single memory block carved into arrays.
+ *
+ * reserve() makes sure the block can hold a given number of bytes, allocating
+ * a new block only when the current one is too small, and rewinds the arena;
+ * allocate() then hands out consecutive, suitably aligned arrays of trivial
+ * types. The arrays live until the next reserve() or the destruction of the
+ * arena, which releases the block in one step, also during stack unwinding.
+ */
+class Arena {
+
+public:
+    Arena(): m_capacity(0), m_used(0) {
+    }
+
+    /**
+     * @brief Returns the bytes needed by an array of \p n elements of type T, including its alignment padding.
+     */
+    template<typename T>
+    static std::size_t bytesFor(std::size_t n) {
+        return n * sizeof(T) + alignof(T) - 1;
+    }
+
+    /**
+     * @brief Rewinds the arena and makes sure it holds at least \p bytes bytes.
+     *
+     * The arrays handed out before are invalidated.
+     *
+     * @return true if a new block was allocated.
+     */
+    bool reserve(std::size_t bytes) {
+        m_used = 0;
+        if (bytes <= m_capacity)
+            return false;
+        m_block.reset(new unsigned char[bytes]);
+        m_capacity = bytes;
+        return true;
+    }
+
+    /**
+     * @brief Hands out an array of \p n elements of the trivial type T.
+     *
+     * @throws std::bad_alloc if the array does not fit in the reserved block.
+     */
+    template<typename T>
+    T* allocate(std::size_t n) {
+        const std::size_t align = alignof(T);
+        const std::size_t address = reinterpret_cast<std::size_t>(m_block.get()) + m_used;
+        const std::size_t start = m_used + (align - address % align) % align;
+        if (start + n * sizeof(T) > m_capacity)
+            throw std::bad_alloc();
+        m_used = start + n * sizeof(T);
+        return reinterpret_cast<T*>(m_block.get() + start);
+    }
+
+    std::size_t capacity() const { return m_capacity; }     ///< Size of the block in bytes
+
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    std::unique_ptr<unsigned char[]> m_block;
+    std::size_t m_capacity;     ///< Size of the block
+    std::size_t m_used;         ///< Bytes handed out since the last reserve()
+};
+
+/**
+ * @class ScratchBuffer
+ * @brief A temporary array borrowed from a pool of buffers kept by each thread.
+ *
+ * The buffer is taken from the pool of the calling thread on construction and
+ * given back, with its capacity, on destruction (also during stack unwinding),
+ * so repeated computations of similar sizes do not allocate memory. Nested
+ * buffers of the same type borrow distinct vectors.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+class ScratchBuffer {
+
+public:
+    /**
+     * @brief Borrows a buffer of \p n elements (with unspecified values).
+     */
+    explicit ScratchBuffer(std::size_t n) {
+        std::vector<std::vector<T> >& free = pool();
+        if (!free.empty()) {
+            m_buffer.swap(free.back());
+            free.pop_back();
+        }
+        m_buffer.resize(n);
+    }
+
+    ~ScratchBuffer() {
+        pool().push_back(std::vector<T>());
+        pool().back().swap(m_buffer);
+    }
+
+    T* data() { return m_buffer.data(); }                     ///< The elements
+    T& operator[](std::size_t i) { return m_buffer[i]; }      ///< Element i
+
+private:
+    ScratchBuffer(const ScratchBuffer&);
+    ScratchBuffer& operator=(const ScratchBuffer&);
+
+    static std::vector<std::vector<T> >& pool() {
+        static thread_local std::vector<std::vector<T> > buffers;
+        return buffers;
+    }
+
+    std::vector<T> m_buffer;
+};
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,96 @@
+/*
+ * BatchEvaluation.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "BatchEvaluation.h"
+#include "CompensatedSum.h"
+#include "DistributionType.h"
+#include "FinitizationCache.h"
+#include "Instrumentation.h"
+#include "ParallelFor.h"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// The objects shared by all the columns with the same structural parameter.
+struct BatchFamily {
+    std::shared_ptr<Finitization> prototype;
+    std::shared_ptr<const PmfTemplate> pmfTemplate;
+};
+
+// Turns the PMF in col into the CDF with the compensated sums of Finitization::computeProbs(),
+// so that the results match the p* functions exactly.
+static void accumulate(double* col, int K) {
+    double sum = 0.0, comp = 0.0;
+    for (int i = 0; i < K; ++i) {
+        compensatedAdd(sum, comp, col[i]);
+        col[i] = sum + comp;
+    }
+}
+
+bool evaluateBatch(int dtype, int n, const double* theta, const int* size, int sizeLen, int m, bool cdf,
+                   int nthreads, double* out) {
+    const bool sized = dtype == DistributionType::BINOMIAL || dtype == DistributionType::NEGATIVEBINOMIAL;
+    if (!sized && dtype != DistributionType::POISSON && dtype != DistributionType::LOGARITHMIC)
+        return false;
+
+    const int K = n + 1;
+    FinitizationCache& cache = FinitizationCache::instance();
+
+    // 1. On the calling thread: one object (and template, if needed) per structural parameter
+    std::vector<BatchFamily> families;
+    std::unordered_map<int, int> familyOf;
+    std::vector<int> columnFamily(m);
+    for (int j = 0; j < m; ++j) {
+        const int s = sized ? size[sizeLen == 1 ? 0 : j] : 0;
+        std::unordered_map<int, int>::const_iterator it = familyOf.find(s);
+        if (it == familyOf.end()) {
+            BatchFamily family;
+            family.prototype = cache.get(DistributionKey(dtype, n, theta[j], s));
+            if (family.prototype->needsTemplate())
+                family.pmfTemplate = cache.getTemplate(*family.prototype);
+            it = familyOf.insert(std::make_pair(s, (int) families.size())).first;
+            families.push_back(family);
+        }
+        columnFamily[j] = it->second;
+    }
+
+    // 2. On the worker threads: numeric evaluation only, each column written by one thread.
+    // The whole loop is timed here, as the instrumentation is not thread-safe.
+    std::vector<char> done(m, 0);
+    {
+        FINITIZATION_TIMER(Instrumentation::NUMERIC);
+        parallelFor(m, nthreads, [&](int begin, int end) {
+            for (int j = begin; j < end; ++j) {
+                const BatchFamily& family = families[columnFamily[j]];
+                double* col = out + (size_t) j * K;
+                if (family.prototype->probabilities(theta[j], family.pmfTemplate.get(), col)) {
+                    if (cdf)
+                        accumulate(col, K);
+                    done[j] = 1;
+                }
+            }
+        });
+    }
+
+    // 3. On the calling thread: symbolic evaluation of the remaining columns. These objects are
+    // built outside the cache, so that a large grid does not evict the distributions in use.
+    for (int j = 0; j < m; ++j) {
+        if (done[j])
+            continue;
+        const int s = sized ? size[sizeLen == 1 ? 0 : j] : 0;
+        double* col = out + (size_t) j * K;
+        const std::unique_ptr<Finitization> f = newFinitization(DistributionKey(dtype, n, theta[j], s));
+        for (int i = 0; i < K; ++i)
+            col[i] = f->fin_pdf(i);
+        if (cdf)
+            accumulate(col, K);
+    }
+    return true;
+}
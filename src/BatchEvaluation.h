@@ -0,0 +1,38 @@
+/*
+ * BatchEvaluation.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef BATCHEVALUATION_H_
+#define BATCHEVALUATION_H_
+
+/**
+ * @brief Evaluates the finitized PMF (or CDF) of one family over many parameter values.
+ *
+ * Column j of the column-major (n+1) x m matrix \p out receives the probabilities
+ * of the distribution with parameter \p theta[j] and structural parameter
+ * \p size[j] (or \p size[0] when \p sizeLen is 1). The symbolic work is shared:
+ * a single distribution object per structural parameter evaluates all its
+ * columns numerically (see Finitization::probabilities()). The numeric
+ * evaluation of the columns is split across \p nthreads worker threads, which
+ * write to disjoint columns of \p out and make no R or GiNaC call. The symbolic
+ * path is used, on the calling thread, only for the columns no numeric method
+ * can handle. Must be called from the R main thread.
+ *
+ * @param dtype Distribution type (see DistributionType).
+ * @param n Finitization order.
+ * @param theta Array of m parameter values (theta, p or q).
+ * @param size Array of N (Binomial) or k (Negative Binomial) values; ignored for the other distributions.
+ * @param sizeLen Length of \p size: 1 or m.
+ * @param m Number of parameter values.
+ * @param cdf If true, the cumulative probabilities are returned instead of the PMF.
+ * @param nthreads Number of worker threads; <= 0 means all the hardware threads.
+ * @param out Output buffer of (n+1) * m values.
+ * @return false if the distribution type is unsupported.
+ */
+bool evaluateBatch(int dtype, int n, const double* theta, const int* size, int sizeLen, int m, bool cdf,
+                   int nthreads, double* out);
+
+#endif /* BATCHEVALUATION_H_ */
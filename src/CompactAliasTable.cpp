@@ -0,0 +1,65 @@
+/*
+ * CompactAliasTable.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "CompactAliasTable.h"
+#include <cmath>
+
+static const double TWO_32 = 4294967296.0;
+
+// Rounds c * scale to the nearest integer in [0, scale - 1]
+static uint32_t quantize(double c, double scale) {
+    const double q = std::floor(c * scale + 0.5);
+    if (q <= 0.0)
+        return 0;
+    return q >= scale - 1.0 ? static_cast<uint32_t>(scale - 1.0) : static_cast<uint32_t>(q);
+}
+
+CompactAliasTable::CompactAliasTable(const double* cutoff, const int* alias, int K, bool narrow):
+    m_K(K), m_narrow(narrow && K <= NARROW_MAX) {
+    const std::size_t size = bytes();
+    m_storage.reset(new char[size + LINE]);
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_storage.get());
+    m_buckets = m_storage.get() + (LINE - address % LINE) % LINE;
+
+    // A full bucket (cutoff 1) quantizes to the largest cutoff and is its own alias, so it always returns itself
+    if (m_narrow) {
+        NarrowBucket* b = static_cast<NarrowBucket*>(m_buckets);
+        for (int i = 0; i < K; ++i) {
+            b[i].cutoff = static_cast<uint16_t>(quantize(cutoff[i], 65536.0));
+            b[i].alias = static_cast<uint16_t>(alias[i]);
+        }
+    }
+    else {
+        WideBucket* b = static_cast<WideBucket*>(m_buckets);
+        for (int i = 0; i < K; ++i) {
+            b[i].cutoff = quantize(cutoff[i], TWO_32);
+            b[i].alias = static_cast<uint32_t>(alias[i]);
+        }
+    }
+}
+
+void CompactAliasTable::sample(const double* u, int count, int* out) const {
+    const uint64_t K = static_cast<uint64_t>(m_K);
+    if (m_narrow) {
+        const NarrowBucket* b = static_cast<const NarrowBucket*>(m_buckets);
+        for (int i = 0; i < count; ++i) {
+            const uint64_t x = static_cast<uint64_t>(u[i] * TWO_32) * K;
+            const uint32_t j = static_cast<uint32_t>(x >> 32);
+            const NarrowBucket bucket = b[j];
+            out[i] = (static_cast<uint32_t>(x) >> 16) < bucket.cutoff ? static_cast<int>(j) : bucket.alias;
+        }
+    }
+    else {
+        const WideBucket* b = static_cast<const WideBucket*>(m_buckets);
+        for (int i = 0; i < count; ++i) {
+            const uint64_t x = static_cast<uint64_t>(u[i] * TWO_32) * K;
+            const uint32_t j = static_cast<uint32_t>(x >> 32);
+            const WideBucket bucket = b[j];
+            out[i] = static_cast<uint32_t>(x) < bucket.cutoff ? static_cast<int>(j) : static_cast<int>(bucket.alias);
+        }
+    }
+}
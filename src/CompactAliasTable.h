@@ -0,0 +1,79 @@
+/*
+ * CompactAliasTable.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef COMPACTALIASTABLE_H_
+#define COMPACTALIASTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class CompactAliasTable
+ * @brief Alias-method tables packed into one cache-line aligned array of buckets.
+ *
+ * Each bucket holds the quantized cutoff of the alias method next to its alias
+ * index, so a draw reads a single bucket instead of two separate arrays. Wide
+ * buckets take 8 bytes (32-bit cutoff and index); narrow buckets take 4 bytes
+ * (16-bit cutoff and index) and need fewer than 65536 support points. The array
+ * starts on a cache line boundary and the bucket size divides the line size, so
+ * no bucket straddles two lines.
+ *
+ * A uniform u is turned into a 32-bit fixed-point number v; the bucket is the
+ * high half of v * K and the fraction compared with the cutoff is its low half.
+ * The probabilities are thus represented with a resolution of 2^-32 (wide) or
+ * 2^-16 (narrow) of a bucket.
+ */
+class CompactAliasTable {
+
+public:
+    static const int WIDE = 8;          ///< Bytes per bucket with 32-bit cutoffs
+    static const int NARROW = 4;        ///< Bytes per bucket with 16-bit cutoffs
+    static const int LINE = 64;         ///< Alignment of the buckets (cache line size)
+    static const int NARROW_MAX = 65535;///< Largest number of support points of narrow buckets
+
+    /**
+     * @brief Quantizes alias tables into packed buckets.
+     *
+     * @param cutoff The cutoffs of the alias method, in [0, 1].
+     * @param alias The alias indices.
+     * @param K The number of support points.
+     * @param narrow If true and K <= NARROW_MAX, 4-byte buckets are used, otherwise 8-byte ones.
+     */
+    CompactAliasTable(const double* cutoff, const int* alias, int K, bool narrow);
+
+    /**
+     * @brief Fills \p out with the draws corresponding to the uniforms \p u.
+     *
+     * @param u The uniforms, in [0, 1).
+     * @param count The number of uniforms.
+     * @param out The output array of \p count values.
+     */
+    void sample(const double* u, int count, int* out) const;
+
+    int size() const { return m_K; }                                      ///< Number of support points
+    bool narrow() const { return m_narrow; }                              ///< True for 4-byte buckets
+    std::size_t bytes() const { return m_K * (m_narrow ? NARROW : WIDE); } ///< Size of the buckets in bytes
+
+private:
+    struct WideBucket {
+        uint32_t cutoff;
+        uint32_t alias;
+    };
+
+    struct NarrowBucket {
+        uint16_t cutoff;
+        uint16_t alias;
+    };
+
+    int m_K;
+    bool m_narrow;
+    std::unique_ptr<char[]> m_storage;  ///< Allocation holding the aligned buckets
+    void* m_buckets;                    ///< The buckets, aligned to LINE bytes
+};
+
+#endif /* COMPACTALIASTABLE_H_ */
@@ -0,0 +1,29 @@
+/*
+ * CompensatedSum.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef COMPENSATEDSUM_H_
+#define COMPENSATEDSUM_H_
+
+#include <cmath>
+
+/**
+ * @brief Neumaier's compensated summation step.
+ *
+ * Adds \p term to the running sum \p sum and accumulates the rounding error in
+ * \p comp; the compensated sum is sum + comp. All the tail sums of the package
+ * are accumulated with this function, so that they agree to the last bit.
+ */
+inline void compensatedAdd(double& sum, double& comp, double term) {
+    const double t = sum + term;
+    if (std::fabs(sum) >= std::fabs(term))
+        comp += (sum - t) + term;
+    else
+        comp += (term - t) + sum;
+    sum = t;
+}
+
+#endif /* COMPENSATEDSUM_H_ */
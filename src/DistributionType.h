@@ -23,6 +23,9 @@ public:
 
     // Identifier for the Logarithmic distribution
     static const int LOGARITHMIC = 3;
+
+    // Identifier for the user-defined families (see FamilyRegistry); the family is the size parameter
+    static const int CUSTOM = 4;
 };
 
 #endif /* DISTRIBUTIONTYPE_H_ */
@@ -0,0 +1,127 @@
+/*
+ * DoubleDouble.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef DOUBLEDOUBLE_H_
+#define DOUBLEDOUBLE_H_
+
+#include <cmath>
+
+/**
+ * @class DoubleDouble
+ * @brief A number represented as the unevaluated sum of two doubles.
+ *
+ * The pair (hi, lo), with |lo| <= ulp(hi) / 2, carries about 106 bits of
+ * significand, so sums with heavy cancellation keep about 16 more digits than
+ * in double precision. Addition, multiplication and division use the
+ * error-free transformations of Dekker and Knuth (two-sum and fused
+ * multiply-add). exp() reduces its argument by a multiple of log(2) and a
+ * factor 512 before a Taylor series, and log() refines the double precision
+ * logarithm by one Newton step on exp(), so both keep the full precision.
+ */
+class DoubleDouble {
+
+public:
+    DoubleDouble(): m_hi(0.0), m_lo(0.0) {
+    }
+
+    DoubleDouble(double hi, double lo = 0.0): m_hi(hi), m_lo(lo) {
+    }
+
+    double hi() const { return m_hi; }                      ///< Leading part
+    double lo() const { return m_lo; }                      ///< Trailing part
+    double toDouble() const { return m_hi + m_lo; }         ///< Value rounded to a double
+
+    friend DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+        double e;
+        const double s = twoSum(a.m_hi, b.m_hi, e);
+        double f;
+        const double t = twoSum(a.m_lo, b.m_lo, f);
+        e += t;
+        double hi = quickTwoSum(s, e, e);
+        e += f;
+        hi = quickTwoSum(hi, e, e);
+        return DoubleDouble(hi, e);
+    }
+
+    friend DoubleDouble operator-(const DoubleDouble& a) {
+        return DoubleDouble(-a.m_hi, -a.m_lo);
+    }
+
+    friend DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) {
+        return a + -b;
+    }
+
+    friend DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+        const double p = a.m_hi * b.m_hi;
+        double e = std::fma(a.m_hi, b.m_hi, -p);
+        e += a.m_hi * b.m_lo + a.m_lo * b.m_hi;
+        const double hi = quickTwoSum(p, e, e);
+        return DoubleDouble(hi, e);
+    }
+
+    friend DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+        // Long division: a double quotient, then a correction from the remainder
+        const double q1 = a.m_hi / b.m_hi;
+        const DoubleDouble r = a - b * DoubleDouble(q1);
+        const double q2 = r.m_hi / b.m_hi;
+        const DoubleDouble s = r - b * DoubleDouble(q2);
+        const double q3 = s.m_hi / b.m_hi;
+        double e;
+        const double hi = quickTwoSum(q1, q2, e);
+        return DoubleDouble(hi, e) + DoubleDouble(q3);
+    }
+
+    friend DoubleDouble log(const DoubleDouble& a) {
+        if (!(a.m_hi > 0.0) || std::isinf(a.m_hi))
+            return DoubleDouble(std::log(a.m_hi));
+        // x + a exp(-x) - 1 doubles the number of correct digits of x
+        const DoubleDouble x(std::log(a.m_hi));
+        return x + a * exp(-x) - DoubleDouble(1.0);
+    }
+
+    friend DoubleDouble exp(const DoubleDouble& a) {
+        if (!(std::fabs(a.m_hi) < 708.0))
+            return DoubleDouble(std::exp(a.m_hi));
+        // exp(a) = 2^m exp(r)^512, with |r| <= log(2) / 1024
+        const DoubleDouble LN2(6.931471805599452862e-01, 2.319046813846299558e-17);
+        const double m = std::floor(a.m_hi / LN2.m_hi + 0.5);
+        const DoubleDouble r = (a - LN2 * DoubleDouble(m)) * DoubleDouble(1.0 / 512.0);
+
+        // s = exp(r) - 1, then exp(2r) - 1 = 2s + s^2 nine times
+        DoubleDouble s = r, t = r;
+        for (int k = 2; k <= 10; ++k) {
+            t = t * r / DoubleDouble(k);
+            s = s + t;
+        }
+        for (int i = 0; i < 9; ++i)
+            s = s * DoubleDouble(2.0) + s * s;
+        s = s + DoubleDouble(1.0);
+        const int e = static_cast<int>(m);
+        return DoubleDouble(std::ldexp(s.m_hi, e), std::ldexp(s.m_lo, e));
+    }
+
+private:
+    // s + e = a + b exactly
+    static double twoSum(double a, double b, double& e) {
+        const double s = a + b;
+        const double v = s - a;
+        e = (a - (s - v)) + (b - v);
+        return s;
+    }
+
+    // s + e = a + b exactly, for |a| >= |b|
+    static double quickTwoSum(double a, double b, double& e) {
+        const double s = a + b;
+        e = b - (s - a);
+        return s;
+    }
+
+    double m_hi;
+    double m_lo;
+};
+
+#endif /* DOUBLEDOUBLE_H_ */
@@ -0,0 +1,27 @@
+#ifndef EVALUATIONENGINE_H_
+#define EVALUATIONENGINE_H_
+
+/**
+ * @class EvaluationEngine
+ * @brief Constants identifying the methods used to compute the finitized probabilities.
+ *
+ * The values follow the order of the engine names accepted by the R function
+ * \c setEvaluationEngine(): "auto", "series", "template", "symbolic".
+ */
+class EvaluationEngine {
+
+public:
+    // Closed-form series coefficients, then the PMF template, then GiNaC
+    static const int AUTO = 0;
+
+    // Closed-form series coefficients, GiNaC when the class has no closed form
+    static const int SERIES = 1;
+
+    // Parameter-independent PMF template, GiNaC when the PMF is not rational
+    static const int TEMPLATE = 2;
+
+    // Symbolic evaluation with GiNaC only
+    static const int SYMBOLIC = 3;
+};
+
+#endif /* EVALUATIONENGINE_H_ */
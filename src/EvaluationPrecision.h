@@ -0,0 +1,21 @@
+#ifndef EVALUATIONPRECISION_H_
+#define EVALUATIONPRECISION_H_
+
+/**
+ * @class EvaluationPrecision
+ * @brief Constants identifying the arithmetic used by the numeric evaluation of the PMF.
+ *
+ * The values follow the order of the names accepted by the R function
+ * \c setEvaluationPrecision(): "double", "double-double".
+ */
+class EvaluationPrecision {
+
+public:
+    // IEEE double precision
+    static const int DOUBLE = 0;
+
+    // Unevaluated sums of two doubles (about 32 significant digits), see DoubleDouble
+    static const int DOUBLE_DOUBLE = 1;
+};
+
+#endif /* EVALUATIONPRECISION_H_ */
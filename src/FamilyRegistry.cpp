@@ -0,0 +1,116 @@
+/*
+ * FamilyRegistry.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "FamilyRegistry.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace Rcpp;
+
+FamilyRegistry::FamilyRegistry(): m_s("s"), m_x("x"), m_theta("theta") {
+}
+
+FamilyRegistry& FamilyRegistry::instance() {
+    static FamilyRegistry registry;
+    return registry;
+}
+
+int FamilyRegistry::add(const std::string& name, const std::string& pgf,
+                        const std::map<std::string, double>& constants) {
+    symtab table;
+    table["s"] = m_s;
+    table["theta"] = m_theta;
+    for (std::map<std::string, double>::const_iterator it = constants.begin(); it != constants.end(); ++it) {
+        if (it->first == "s" || it->first == "theta")
+            stop("The constant %s has the name of a variable.", it->first);
+        // Integers stay exact, so that a rational PGF keeps a rational PMF. Beyond 2^53 (or the
+        // range of long) a double is not known to be an exact integer and the cast is not defined.
+        const double value = it->second;
+        if (!std::isfinite(value))
+            stop("The constant %s is not finite.", it->first);
+        const double exact = std::min(9007199254740992.0, static_cast<double>(std::numeric_limits<long>::max()));
+        if (std::fabs(value) < exact && value == std::floor(value))
+            table[it->first] = numeric(static_cast<long>(value));
+        else
+            table[it->first] = numeric(value);
+    }
+
+    ex g;
+    try {
+        parser reader(table, true);
+        g = reader(pgf);
+    }
+    catch (const std::exception& e) {
+        stop("Cannot parse the PGF %s: %s", pgf, e.what());
+    }
+    if (!(g.subs(m_s == 1) - 1).normal().is_zero())
+        stop("The PGF %s is not 1 at s = 1.", pgf);
+
+    // The same PGF keeps its identifier, and thus its cached templates and kernels
+    const unsigned hash = g.gethash();
+    int id = -1;
+    for (size_t f = 0; f < m_families.size() && id < 0; ++f)
+        if (m_families[f].hash == hash && m_families[f].pgf.is_equal(g))
+            id = static_cast<int>(f);
+    if (id < 0) {
+        Family family;
+        family.pgf = g;
+        family.base = g.subs(m_s == 1 + m_x / m_theta);
+        family.hash = hash;
+        m_families.push_back(family);
+        id = static_cast<int>(m_families.size()) - 1;
+    }
+
+    for (size_t i = 0; i < m_names.size(); ++i) {
+        if (m_names[i].first == name) {
+            m_names[i].second = id;
+            return id;
+        }
+    }
+    m_names.push_back(std::make_pair(name, id));
+    return id;
+}
+
+int FamilyRegistry::find(const std::string& name) const {
+    for (size_t i = 0; i < m_names.size(); ++i)
+        if (m_names[i].first == name)
+            return m_names[i].second;
+    return -1;
+}
+
+const ex& FamilyRegistry::base(int id) const {
+    if (id < 0 || id >= static_cast<int>(m_families.size()))
+        stop("Unknown user-defined family %d.", id);
+    return m_families[id].base;
+}
+
+std::string FamilyRegistry::pgf(int id) const {
+    if (id < 0 || id >= static_cast<int>(m_families.size()))
+        stop("Unknown user-defined family %d.", id);
+    std::ostringstream out;
+    out << m_families[id].pgf;
+    return out.str();
+}
+
+std::vector<std::string> FamilyRegistry::names() const {
+    std::vector<std::string> result;
+    for (size_t i = 0; i < m_names.size(); ++i)
+        result.push_back(m_names[i].first);
+    return result;
+}
+
+const symbol& FamilyRegistry::variable() const {
+    return m_x;
+}
+
+const symbol& FamilyRegistry::parameter() const {
+    return m_theta;
+}
@@ -0,0 +1,99 @@
+/*
+ * FamilyRegistry.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef FAMILYREGISTRY_H_
+#define FAMILYREGISTRY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <ginac/ginac.h>
+
+using namespace GiNaC;
+
+/**
+ * @class FamilyRegistry
+ * @brief The user-defined families of distributions, given by their probability generating functions.
+ *
+ * A family is registered with a name and its PGF G(s; theta), an expression in the
+ * variable s and the parameter theta read by the GiNaC parser, e.g.
+ * "(exp(theta*s) - 1)/(exp(theta) - 1)" for the zero-truncated Poisson distribution.
+ * Its native series, in the form expected by Finitization::ntsd_base(), is
+ * G(1 + x / theta): the k-th derivative of this function at x = -theta, times
+ * theta^k / k!, is the probability of k. The distributions of a family are then
+ * built by FinitizedCustomDistribution, with the type DistributionType::CUSTOM
+ * and the identifier of the family as size parameter, so the cache of finitized
+ * distributions, the PMF templates and the compiled kernels are shared by all the
+ * distributions of a family.
+ *
+ * Families are identified by their PGF: a name registered again with an equal
+ * expression (same hash, then compared symbolically) gets the identifier it
+ * already had, so its templates and kernels are derived only once.
+ */
+class FamilyRegistry {
+
+public:
+    /**
+     * @brief Returns the single instance of the registry.
+     */
+    static FamilyRegistry& instance();
+
+    /**
+     * @brief Registers the family of PGF \p pgf under the name \p name.
+     *
+     * @param name The name of the family; a name registered before then refers to the new PGF.
+     * @param pgf The PGF, a function of s and theta.
+     * @param constants Names and values of constants that may appear in \p pgf.
+     * @return The identifier of the family.
+     * @throws Rcpp::exception if the PGF cannot be parsed or is not 1 at s = 1.
+     */
+    int add(const std::string& name, const std::string& pgf, const std::map<std::string, double>& constants);
+
+    /**
+     * @brief Returns the identifier of the family named \p name, -1 if there is none.
+     */
+    int find(const std::string& name) const;
+
+    /**
+     * @brief Returns the native series of a family, G(1 + x / theta), as a function of variable() and parameter().
+     *
+     * @throws Rcpp::exception if \p id is not a registered family.
+     */
+    const ex& base(int id) const;
+
+    /**
+     * @brief Returns the PGF of a family as it was parsed.
+     */
+    std::string pgf(int id) const;
+
+    /**
+     * @brief Returns the names of the families, in the order of their registration.
+     */
+    std::vector<std::string> names() const;
+
+    const symbol& variable() const;     ///< The symbol x of the native series
+    const symbol& parameter() const;    ///< The symbol theta
+
+private:
+    FamilyRegistry();
+    FamilyRegistry(const FamilyRegistry&);
+    FamilyRegistry& operator=(const FamilyRegistry&);
+
+    struct Family {
+        ex pgf;             ///< G(s; theta)
+        ex base;            ///< G(1 + x / theta; theta)
+        unsigned hash;      ///< Hash of the PGF
+    };
+
+    symbol m_s;
+    symbol m_x;
+    symbol m_theta;
+    std::vector<Family> m_families;                 ///< Indexed by identifier
+    std::vector<std::pair<std::string, int> > m_names;    ///< Names and identifiers, in registration order
+};
+
+#endif /* FAMILYREGISTRY_H_ */
@@ -6,18 +6,32 @@
  */
 
 #include "Finitization.h"
+#include "FinitizationCache.h"
+#include "PmfTemplate.h"
+#include "EvaluationEngine.h"
+#include "EvaluationPrecision.h"
+#include "DoubleDouble.h"
+#include "AliasKernel.h"
+#include "CompactAliasTable.h"
+#include "ParallelFor.h"
+#include "Xoshiro256.h"
+#include "Instrumentation.h"
+#include "Arena.h"
+#include "CompensatedSum.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
 using namespace std;
 
-#ifndef RESTRICT
-#if defined(__GNUC__) || defined(__clang__)
-#define RESTRICT __restrict__
-#else
-#define RESTRICT
-#endif
-#endif
-
 static const int K_LADDER_MAX = 8;
 
+int Finitization::s_engine = EvaluationEngine::AUTO;
+int Finitization::s_precision = EvaluationPrecision::DOUBLE;
+const int Finitization::SAMPLE_BLOCK;
+
 #if defined(_MSC_VER)
 #define FORCEINLINE __forceinline
 #else
@@ -58,220 +72,387 @@ FORCEINLINE int sample_cdf_ladder_runtime(int K, double u, const double* cdf, co
 }
 
 
-Finitization::Finitization(int n): m_finitizationOrder(n), m_dprobs{nullptr}, m_finish{false} {
-    // Memory allocation for alias method
-    const int K = m_finitizationOrder + 1;
-    m_alias = new int[K];
-    m_prob = new double[K];
-    m_values = new int[K];
-    m_ntsfFirstTime = true;
-    for(int i = 0; i <= n; i++)
-        m_values[i] = i;
-
-    // optional small-K PMF cache (allocated lazily in setProbs)
-    m_pmf_small = nullptr;
-    m_smallK    = false;
-}
-
-Finitization::~Finitization() {
-    delete[] m_alias;
-    delete[] m_prob;
-    delete[] m_values;
-    delete[] m_dprobs;
-    if (m_pmf_small) {
-        delete[] m_pmf_small;
-        m_pmf_small = nullptr;
-    }
-}
-
-void Finitization::setProbs(double* p) {
-    const int K = m_finitizationOrder + 1;
-    if (K <= 0) stop("Internal: K <= 0 in setProbs.");
-
-    // 1) Normalize p -> prob
-    double sum = 0.0;
-    for (int i = 0; i < K; ++i) {
-        if (p[i] < 0.0) stop("Negative probability at index %d.", i);
-        sum += p[i];
-    }
-    if (sum <= 0.0) stop("Sum of probabilities is zero in setProbs().");
-    const double inv_sum = 1.0 / sum;
-
-    // --- small-K PMF cache for macOS CDF ladder (K <= K_LADDER_MAX) ---
-    if (K <= K_LADDER_MAX) {
-        if (!m_pmf_small) {
-            m_pmf_small = new double[K];
-        }
-        for (int i = 0; i < K; ++i) {
-            m_pmf_small[i] = p[i] * inv_sum;  // normalized pmf
-        }
-        m_smallK = true;
-    } else {
-        if (m_pmf_small) {
-            delete[] m_pmf_small;
-            m_pmf_small = nullptr;
-        }
-        m_smallK = false;
-    }
-
-    // 2) Scale by K (Vose/Walker) and partition into small/large
-    double* P = new double[K];
+// Walker/Vose alias tables of the normalized pmf p[0..K).
+static void buildAliasTable(const double* p, int K, double* cutoff, int* alias) {
+    // 1) Scale by K and partition into small/large
+    ScratchBuffer<double> P(K);
     for (int i = 0; i < K; ++i)
-        P[i] = (p[i] * inv_sum) * static_cast<double>(K);
+        P[i] = p[i] * static_cast<double>(K);
 
-    int* S = new int[K];
-    int* L = new int[K];
+    ScratchBuffer<int> S(K);
+    ScratchBuffer<int> L(K);
     int nS = 0, nL = 0;
 
     for (int i = K - 1; i >= 0; --i) {
         (P[i] < 1.0) ? (S[nS++] = i) : (L[nL++] = i);
     }
 
-    // 3) Build alias table
+    // 2) Build alias table
     while (nS && nL) {
         const int a = S[--nS];
         const int g = L[--nL];
 
-        m_prob[a]  = P[a];
-        m_alias[a] = g;
+        cutoff[a] = P[a];
+        alias[a]  = g;
 
         P[g] = (P[g] + P[a]) - 1.0;
         (P[g] < 1.0) ? (S[nS++] = g) : (L[nL++] = g);
     }
 
-    // 4) Leftovers
+    // 3) Leftovers
     while (nL) {
         const int i = L[--nL];
-        m_prob[i]  = 1.0;
-        m_alias[i] = i;
+        cutoff[i] = 1.0;
+        alias[i]  = i;
     }
     while (nS) {
         const int i = S[--nS];
-        m_prob[i]  = 1.0;
-        m_alias[i] = i;
+        cutoff[i] = 1.0;
+        alias[i]  = i;
     }
-
-    delete[] P;
-    delete[] S;
-    delete[] L;
 }
 
-IntegerVector Finitization::rvalues(int no) {
-    if (no < 0) {
-        stop("'no' must be nonnegative.");
+// CDF of the normalized pmf p[0..K), with cdf[K-1] = 1 exactly.
+static void buildCdf(const double* p, int K, double* cdf) {
+    double acc = 0.0;
+    for (int i = 0; i < K; ++i) {
+        acc += p[i];
+        cdf[i] = acc;
     }
+    cdf[K - 1] = 1.0;
+}
 
-    const int K  = m_finitizationOrder + 1;
-    const double* RESTRICT cutoff = m_prob;
-    const int*    RESTRICT alias  = m_alias;
+// CDF ladder: the support sorted by decreasing probability and its CDF.
+static void buildLadder(const double* p, int K, double* cdf, int* idx) {
+    ScratchBuffer<double> prob(K);
+    for (int i = 0; i < K; ++i) {
+        prob[i] = p[i];
+        idx[i]  = i;
+    }
 
-    IntegerVector out(no);
-    int* RESTRICT p = out.begin();
+    // Sort by decreasing probability (insertion sort, the ladder is meant for small K)
+    for (int i = 1; i < K; ++i) {
+        double key_p = prob[i];
+        int    key_i = idx[i];
+        int j = i - 1;
+        while (j >= 0 && prob[j] < key_p) {
+            prob[j + 1] = prob[j];
+            idx[j + 1]  = idx[j];
+            --j;
+        }
+        prob[j + 1] = key_p;
+        idx[j + 1]  = key_i;
+    }
 
-    GetRNGstate();
+    buildCdf(prob.data(), K, cdf);
+}
 
-#if defined(__APPLE__)
-    // ===== APPLE: small-K path with probability-ordered ladder =====
-    if (K <= K_LADDER_MAX && m_pmf_small != nullptr) {
-        // Copy pmf and indices into small local arrays
-        alignas(64) double prob[8];
-        alignas(64) int    idx[8];
-        alignas(64) double cdf_ladder[8];
+static void sampleLadder(const double* u, int count, int K, const double* cdf, const int* idx, int* out) {
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 0; i < count; ++i)
+        out[i] = sample_cdf_ladder_runtime(K, u[i], cdf, idx);
+}
 
-        for (int i = 0; i < K; ++i) {
-            prob[i] = m_pmf_small[i];  // normalized pmf for state i
-            idx[i]  = i;               // original support value
+static void sampleInversion(const double* u, int count, int K, const double* cdf, int* out) {
+    for (int i = 0; i < count; ++i) {
+        // First t with u < cdf[t]; points with probability 0 are never returned
+        int lo = 0, hi = K - 1;
+        while (lo < hi) {
+            const int mid = (lo + hi) >> 1;
+            if (u[i] < cdf[mid])
+                hi = mid;
+            else
+                lo = mid + 1;
         }
+        out[i] = lo;
+    }
+}
 
-        // Sort by decreasing probability (tiny insertion sort, K<=4)
-        for (int i = 1; i < K; ++i) {
-            double key_p = prob[i];
-            int    key_i = idx[i];
-            int j = i - 1;
-            while (j >= 0 && prob[j] < key_p) {
-                prob[j + 1] = prob[j];
-                idx[j + 1]  = idx[j];
-                --j;
-            }
-            prob[j + 1] = key_p;
-            idx[j + 1]  = key_i;
-        }
+// Sampling tables of one distribution
+struct SamplingTables {
+    int K;
+    const double* cutoff;       // alias method
+    const int* alias;
+    const double* cdf;          // inversion
+    const double* ladderCdf;    // ladder
+    const int* ladderIdx;
+    const CompactAliasTable* compact;   // compact alias method, if built
+};
+
+static void sampleWith(int sampler, const SamplingTables& t, const double* u, int count, int* out) {
+    switch (sampler) {
+    case SamplerType::LADDER:
+        sampleLadder(u, count, t.K, t.ladderCdf, t.ladderIdx, out);
+        break;
+    case SamplerType::INVERSION:
+        sampleInversion(u, count, t.K, t.cdf, out);
+        break;
+    case SamplerType::COMPACT:
+    case SamplerType::COMPACT16:
+        t.compact->sample(u, count, out);
+        break;
+    default:
+        AliasKernel::sample(u, count, t.K, t.cutoff, t.alias, out);
+        break;
+    }
+}
 
-        // Build CDF in sorted order
-        double acc = 0.0;
-        for (int i = 0; i < K; ++i) {
-            acc += prob[i];
-            cdf_ladder[i] = acc;
+// Times the samplers on a geometric pmf with K points and returns the fastest one.
+static int calibrateSampler(int K) {
+    double p[K_LADDER_MAX], cutoff[K_LADDER_MAX], cdf[K_LADDER_MAX], ladderCdf[K_LADDER_MAX];
+    int alias[K_LADDER_MAX], ladderIdx[K_LADDER_MAX];
+    double sum = 0.0;
+    for (int i = 0; i < K; ++i)
+        sum += (p[i] = std::pow(0.5, i));
+    for (int i = 0; i < K; ++i)
+        p[i] /= sum;
+    buildAliasTable(p, K, cutoff, alias);
+    buildCdf(p, K, cdf);
+    buildLadder(p, K, ladderCdf, ladderIdx);
+    const SamplingTables t = { K, cutoff, alias, cdf, ladderCdf, ladderIdx, nullptr };
+
+    const int N = 4096, REPS = 8;
+    std::vector<double> u(N);
+    std::vector<int> out(N);
+    Xoshiro256 g(K);
+    for (int i = 0; i < N; ++i)
+        u[i] = g.nextDouble();
+
+    const int candidates[] = { SamplerType::ALIAS, SamplerType::LADDER, SamplerType::INVERSION };
+    volatile int sink = 0;      // keeps the timed loops from being optimized away
+    int best = SamplerType::ALIAS;
+    double bestTime = std::numeric_limits<double>::infinity();
+    for (int c = 0; c < 3; ++c) {
+        double time = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < REPS; ++r) {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            sampleWith(candidates[c], t, u.data(), N, out.data());
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            time = std::min(time, elapsed.count());
+            sink = out[r];
         }
-        cdf_ladder[K - 1] = 1.0; // enforce exact 1
-
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC unroll 16
-#endif
-        for (int i = 0; i < no; ++i) {
-            p[i] = sample_cdf_ladder_runtime(K, unif_rand(), cdf_ladder, idx);
+        if (time < bestTime) {
+            bestTime = time;
+            best = candidates[c];
         }
+    }
+    return best;
+}
+
+int Finitization::selectSampler(int sampler, int K) {
+    if (sampler == SamplerType::ALIAS || sampler == SamplerType::LADDER || sampler == SamplerType::INVERSION ||
+        sampler == SamplerType::COMPACT || sampler == SamplerType::COMPACT16)
+        return sampler;
+    if (K > K_LADDER_MAX)
+        return SamplerType::ALIAS;
+    if (sampler != SamplerType::CALIBRATED)
+        return SamplerType::LADDER;
+
+    // One calibration run per support size, on the first request
+    static int calibrated[K_LADDER_MAX + 1] = { 0 };
+    if (calibrated[K] == 0)
+        calibrated[K] = calibrateSampler(K);
+    return calibrated[K];
+}
+
+Finitization::Finitization(int n): m_finitizationOrder(n), m_dprobs{nullptr}, m_finish{false},
+    m_lowerCdf{nullptr}, m_upperCdf{nullptr} {
+    m_ntsfFirstTime = true;
+    allocateTables();
+}
+
+Finitization::Finitization(const Finitization& other): m_finitizationOrder(other.m_finitizationOrder),
+    m_theta(other.m_theta), m_paramSymb(other.m_paramSymb), m_x(other.m_x), m_dprobs{nullptr},
+    m_finish(other.m_finish), m_lowerCdf{nullptr}, m_upperCdf{nullptr}, m_ntsfFirstTime(other.m_ntsfFirstTime),
+    m_ntsfSymb(other.m_ntsfSymb), m_cache(other.m_cache), m_programs(other.m_programs) {
+    allocateTables();
+    const int K = m_finitizationOrder + 1;
+    std::copy(other.m_dprobs, other.m_dprobs + K, m_dprobs);
+    std::copy(other.m_lowerCdf, other.m_lowerCdf + K, m_lowerCdf);
+    std::copy(other.m_upperCdf, other.m_upperCdf + K, m_upperCdf);
+    std::copy(other.m_alias, other.m_alias + K, m_alias);
+    std::copy(other.m_prob, other.m_prob + K, m_prob);
+    std::copy(other.m_cdf, other.m_cdf + K, m_cdf);
+    std::copy(other.m_ladderCdf, other.m_ladderCdf + K, m_ladderCdf);
+    std::copy(other.m_ladderIdx, other.m_ladderIdx + K, m_ladderIdx);
+}
+
+Finitization::~Finitization() {
+    releaseTables();
+}
 
-        PutRNGstate();
-        return out;
+void Finitization::allocateTables() {
+    // The probabilities and the sampling tables are carved from one block, which is
+    // reallocated only when the finitization order grows beyond its capacity.
+    const int K = m_finitizationOrder + 1;
+    if (m_arena.reserve(6 * Arena::bytesFor<double>(K) + 3 * Arena::bytesFor<int>(K)))
+        FINITIZATION_COUNT(Instrumentation::BYTES, static_cast<double>(m_arena.capacity()));
+    m_dprobs = m_arena.allocate<double>(K);
+    m_lowerCdf = m_arena.allocate<double>(K);
+    m_upperCdf = m_arena.allocate<double>(K);
+    m_alias = m_arena.allocate<int>(K);
+    m_prob = m_arena.allocate<double>(K);
+    m_cdf = m_arena.allocate<double>(K);
+    m_ladderCdf = m_arena.allocate<double>(K);
+    m_ladderIdx = m_arena.allocate<int>(K);
+    m_values = m_arena.allocate<int>(K);
+    for(int i = 0; i < K; i++)
+        m_values[i] = i;
+}
+
+void Finitization::releaseTables() {
+    // The block itself stays with the arena and is reused by the next allocateTables()
+    m_dprobs = m_lowerCdf = m_upperCdf = m_prob = m_cdf = m_ladderCdf = nullptr;
+    m_alias = m_ladderIdx = m_values = nullptr;
+    m_compact.reset();
+}
+
+void Finitization::extendOrder(int order) {
+    if (order <= m_finitizationOrder)
+        return;
+
+    // The symbolic state, if any, is extended with the new terms of the series instead of being rebuilt:
+    // the derivatives of the new terms (monomials) are added to the cached derivatives of the old series.
+    if (!m_ntsfFirstTime) {
+        const ex extended = series_to_poly(ntsd_base(m_x, m_paramSymb).series(m_x == 0, order + 1));
+        const ex terms = (extended - m_ntsfSymb).expand();
+        for (std::unordered_map<int, ex>::iterator it = m_cache.begin(); it != m_cache.end(); ++it)
+            it->second = it->second + terms.diff(m_x, it->first);
+        m_ntsfSymb = extended;
     }
-#endif
+    m_programs.clear();
 
-    // ===== General alias path for all other cases / platforms =====
-    const double Kd = static_cast<double>(K);
-    constexpr int UN = 16;
-    const int nU = (no / UN) * UN;
+    releaseTables();
+    m_finitizationOrder = order;
+    allocateTables();
 
-    int t = 0;
-    for (; t < nU; t += UN, p += UN) {
+    m_finish = false;
+    computeProbs();
+}
 
-        double   uK[UN];
-        uint32_t j[UN];
-        float    f[UN];
+void Finitization::setProbs(double* p) {
+    FINITIZATION_TIMER(Instrumentation::TABLES);
+    const int K = m_finitizationOrder + 1;
+    if (K <= 0) stop("Internal: K <= 0 in setProbs.");
 
-        // 1) Generate uniforms scaled by K
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC unroll 16
-#endif
-        for (int i = 0; i < UN; ++i) {
-            uK[i] = unif_rand() * Kd;
-        }
+    // Normalize p
+    double sum = 0.0;
+    for (int i = 0; i < K; ++i) {
+        if (p[i] < 0.0) stop("Negative probability at index %d.", i);
+        sum += p[i];
+    }
+    if (sum <= 0.0) stop("Sum of probabilities is zero in setProbs().");
+    const double inv_sum = 1.0 / sum;
 
-        // 2) Split into integer bucket j and fractional part f
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC unroll 16
-#endif
-        for (int i = 0; i < UN; ++i) {
-            const double uki = uK[i];
-            const uint32_t ji = (uint32_t)uki;         // floor for uki>=0
-            j[i] = ji;
-            f[i] = (float)(uki - (double)ji);
-        }
+    ScratchBuffer<double> pmf(K);
+    for (int i = 0; i < K; ++i)
+        pmf[i] = p[i] * inv_sum;
 
-        // 3) Alias decision + write output
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC unroll 16
-#endif
-        for (int i = 0; i < UN; ++i) {
-            const uint32_t jj = j[i];
-            // cutoff is double in your class; compare in float is fine, but keep cutoff as double
-            p[i] = ((double)f[i] < cutoff[jj]) ? (int)jj : alias[jj];
+    buildAliasTable(pmf.data(), K, m_prob, m_alias);
+    buildCdf(pmf.data(), K, m_cdf);
+    buildLadder(pmf.data(), K, m_ladderCdf, m_ladderIdx);
+    m_compact.reset();
+}
+
+void Finitization::aliasTables(double* cutoff, int* alias) const {
+    const int K = m_finitizationOrder + 1;
+    std::copy(m_prob, m_prob + K, cutoff);
+    std::copy(m_alias, m_alias + K, alias);
+}
+
+SamplingTables Finitization::samplingTables(int sampler) {
+    const int K = m_finitizationOrder + 1;
+    if (sampler == SamplerType::COMPACT || sampler == SamplerType::COMPACT16) {
+        // The compact tables are built on demand, from the alias tables
+        const bool narrow = (sampler == SamplerType::COMPACT16);
+        if (!m_compact || m_compact->narrow() != (narrow && K <= CompactAliasTable::NARROW_MAX)) {
+            m_compact.reset(new CompactAliasTable(m_prob, m_alias, K, narrow));
+            FINITIZATION_COUNT(Instrumentation::BYTES, m_compact->bytes() + CompactAliasTable::LINE);
         }
     }
+    const SamplingTables tables = { K, m_prob, m_alias, m_cdf, m_ladderCdf, m_ladderIdx, m_compact.get() };
+    return tables;
+}
 
-    for (int r = nU; r < no; ++r, ++p) {
-        const double uK = unif_rand() * Kd;
-        const uint32_t j = (uint32_t)uK;
-        const double   f = uK - (double)j;
-        *p = (f < cutoff[j]) ? (int)j : alias[j];
+IntegerVector Finitization::rvalues(int no, int sampler) {
+    if (no < 0) {
+        stop("'no' must be nonnegative.");
+    }
+
+    FINITIZATION_TIMER(Instrumentation::SAMPLING);
+    const int K  = m_finitizationOrder + 1;
+    sampler = selectSampler(sampler, K);
+    const SamplingTables tables = samplingTables(sampler);
+
+    IntegerVector out(no);
+    int* p = out.begin();
+
+    GetRNGstate();
+
+    // Uniforms are generated in blocks and turned into draws by the selected sampler
+    double u[AliasKernel::BUFFER];
+    for (int t = 0; t < no; t += AliasKernel::BUFFER) {
+        const int count = std::min(AliasKernel::BUFFER, no - t);
+        for (int i = 0; i < count; ++i)
+            u[i] = unif_rand();
+        sampleWith(sampler, tables, u, count, p + t);
     }
 
     PutRNGstate();
     return out;
 }
+
+// Fills out[0..no) with draws of the selected sampler using the generator g.
+static void sampleStream(Xoshiro256& g, int sampler, const SamplingTables& tables, int* out, int no) {
+    double u[AliasKernel::BUFFER];
+    for (int t = 0; t < no; t += AliasKernel::BUFFER) {
+        const int count = std::min(AliasKernel::BUFFER, no - t);
+        for (int i = 0; i < count; ++i)
+            u[i] = g.nextDouble();
+        sampleWith(sampler, tables, u, count, out + t);
+    }
+}
+
+IntegerVector Finitization::rvalues(int no, int nthreads, int sampler) {
+    if (no < 0) {
+        stop("'no' must be nonnegative.");
+    }
+
+    ValueStream s = newStream();
+    IntegerVector out(no);
+    stream(s, out.begin(), no, nthreads, sampler);
+    return out;
+}
+
+ValueStream Finitization::newStream() {
+    return ValueStream(newSeed());
+}
+
+uint64_t Finitization::newSeed() {
+    GetRNGstate();
+    const uint64_t hi = static_cast<uint64_t>(unif_rand() * 4294967296.0);
+    const uint64_t lo = static_cast<uint64_t>(unif_rand() * 4294967296.0);
+    PutRNGstate();
+    return (hi << 32) | lo;
+}
+
+void Finitization::stream(ValueStream& s, int* out, std::size_t count, int nthreads, int sampler) {
+    FINITIZATION_TIMER(Instrumentation::SAMPLING);
+    const int K = m_finitizationOrder + 1;
+    sampler = selectSampler(sampler, K);
+    const SamplingTables tables = samplingTables(sampler);
+
+    s.generate(count, nthreads, [&tables, sampler, out](Xoshiro256& g, std::size_t from, int n) {
+        sampleStream(g, sampler, tables, out + from, n);
+    });
+}
+
 ex Finitization::ntsf( ex pnb) {
 
     if(m_ntsfFirstTime) {
+        FINITIZATION_TIMER(Instrumentation::SERIES);
         m_ntsfSymb = series_to_poly(pnb.series(m_x == 0, m_finitizationOrder+1));
         m_ntsfFirstTime = false;
     }
@@ -279,15 +460,21 @@ ex Finitization::ntsf( ex pnb) {
 }
 
 ex Finitization::pdf(ex ntsf, int x_val) {
+    FINITIZATION_TIMER(Instrumentation::DERIVATIVES);
     ex optheta = -m_paramSymb;
-    ex pdf;
-    if( x_val > 1 && m_cache.find(x_val-1) != m_cache.end()) {
-        pdf = m_cache[x_val-1].diff(m_x, 1);
-        m_cache.insert({x_val, pdf});
-    }
-    else {
-        pdf = ntsf.diff(m_x, x_val);
-        m_cache.insert({x_val, pdf});
+
+    // Differentiate from the highest derivative already cached below x_val, caching the intermediate ones,
+    // so that a sweep over x = 0, ..., n takes n derivatives in any order of the calls
+    int from = x_val;
+    std::unordered_map<int, ex>::const_iterator it = m_cache.find(from);
+    while (it == m_cache.end() && from > 0)
+        it = m_cache.find(--from);
+    ex pdf = (it != m_cache.end()) ? it->second : ntsf;
+    if (it == m_cache.end())
+        m_cache.insert({0, pdf});
+    for (int j = from + 1; j <= x_val; ++j) {
+        pdf = pdf.diff(m_x, 1);
+        m_cache.insert({j, pdf});
     }
 
     pdf = pdf.subs(m_x == optheta) * pow(m_paramSymb, x_val) / factorial(x_val);
@@ -295,6 +482,15 @@ ex Finitization::pdf(ex ntsf, int x_val) {
 
 }
 
+std::vector<ex> Finitization::symbolicPmfs() {
+    const ex poly = ntsf(ntsd_base(m_x, m_paramSymb));
+    std::vector<ex> result;
+    result.reserve(m_finitizationOrder + 1);
+    for (int x = 0; x <= m_finitizationOrder; ++x)
+        result.push_back(pdf(poly, x));
+    return result;
+}
+
 ex Finitization::fin_pdfSymb(int x_val) {
     ex pdf_ = pdf(ntsf(ntsd_base(m_x, m_paramSymb)), x_val);
     return pdf_;
@@ -315,10 +511,12 @@ GiNaC::ex map_double_and_zero_eps(const GiNaC::ex& e) {
 }
 
 string Finitization::pdfToString(int val, bool tolatex) {
-    stringstream result;
-    ex pdf_ = fin_pdfSymb(val);
+    return pdfToString(fin_pdfSymb(val), tolatex);
+}
 
-    pdf_ = map_double_and_zero_eps(pdf_); // then ensure atoms are made from doubles
+string Finitization::pdfToString(const ex& pdf, bool tolatex) {
+    stringstream result;
+    ex pdf_ = map_double_and_zero_eps(pdf); // then ensure atoms are made from doubles
 
     if(tolatex)
         result << latex;
@@ -327,19 +525,282 @@ string Finitization::pdfToString(int val, bool tolatex) {
 }
 
 
+// Zeroes magnitudes below the numerical noise level and clamps negative values to 0.
+static double cleanProbability(double tmp) {
+    const double eps   = std::numeric_limits<double>::epsilon();
+    const double atmp  = std::abs(tmp);
+    const double scale = std::max(1.0, atmp);
+    const double tol   = 64.0 * eps * scale + 1e-300; // denormal floor
+    double x = (atmp <= tol) ? 0.0 : tmp;  // zero tiny magnitudes
+    x = std::max(x, 0.0);
+    return x;
+}
+
 double Finitization::fin_pdf(int val) {
     if(m_finish && val <= m_finitizationOrder)
         return m_dprobs[val];
     else {
-        ex pdf_ = fin_pdfSymb(val);
-        double tmp = GiNaC::ex_to<GiNaC::numeric>(evalf(pdf_.subs(m_paramSymb == m_theta))).to_double();
-        const double eps   = std::numeric_limits<double>::epsilon();
-        const double atmp  = std::abs(tmp);
-        const double scale = std::max(1.0, atmp);
-        const double tol   = 64.0 * eps * scale + 1e-300; // denormal floor
-        double x = (atmp <= tol) ? 0.0 : tmp;  // zero tiny magnitudes
-        x = std::max(x, 0.0);
-        return x;
+        // The symbolic PMF is compiled once; CLN arithmetic is left for what the compiler does not support
+        std::unordered_map<int, PmfProgram>::iterator it = m_programs.find(val);
+        if (it == m_programs.end()) {
+            PmfProgram program;
+            program.compile(fin_pdfSymb(val), m_paramSymb);
+            it = m_programs.insert({val, program}).first;
+        }
+        double tmp;
+        {
+            FINITIZATION_TIMER(Instrumentation::EVALUATION);
+            tmp = it->second.evaluate(m_theta, s_precision == EvaluationPrecision::DOUBLE_DOUBLE);
+        }
+        if (!std::isfinite(tmp)) {
+            ex pdf_ = fin_pdfSymb(val);
+            FINITIZATION_TIMER(Instrumentation::EVALUATION);
+            tmp = GiNaC::ex_to<GiNaC::numeric>(evalf(pdf_.subs(m_paramSymb == m_theta))).to_double();
+        }
+        return cleanProbability(tmp);
+    }
+}
+
+int Finitization::getSizeParameter() const {
+    return 0;
+}
+
+int Finitization::getOrder() const {
+    return m_finitizationOrder;
+}
+
+double Finitization::getTheta() const {
+    return m_theta;
+}
+
+const symbol& Finitization::getParameterSymbol() const {
+    return m_paramSymb;
+}
+
+std::shared_ptr<PmfTemplate> Finitization::buildTemplate() {
+    FINITIZATION_TIMER(Instrumentation::TEMPLATE);
+    std::shared_ptr<PmfTemplate> tpl = std::make_shared<PmfTemplate>();
+    for (int i = 0; i <= m_finitizationOrder; ++i) {
+        if (!tpl->append(fin_pdfSymb(i), m_paramSymb))
+            break;
+    }
+    return tpl;
+}
+
+std::shared_ptr<std::vector<PmfProgram> > Finitization::buildKernel() {
+    FINITIZATION_TIMER(Instrumentation::TEMPLATE);
+    std::shared_ptr<std::vector<PmfProgram> > kernel = std::make_shared<std::vector<PmfProgram> >(m_finitizationOrder + 1);
+    const std::vector<ex> pmfs = symbolicPmfs();
+    for (int i = 0; i <= m_finitizationOrder; ++i) {
+        if (!(*kernel)[i].compile(pmfs[i], m_paramSymb)) {
+            kernel->clear();
+            break;
+        }
+    }
+    return kernel;
+}
+
+bool Finitization::seriesCoefficients(double theta, double* b) const {
+    return false;
+}
+
+bool Finitization::seriesCoefficients(double theta, DoubleDouble* b) const {
+    return false;
+}
+
+bool Finitization::seriesConstants(double* a) const {
+    return false;
+}
+
+double Finitization::seriesArgument(double theta) const {
+    return theta;
+}
+
+double Finitization::seriesParameter(double u) const {
+    return u;
+}
+
+bool Finitization::pmfPolynomial(int x, std::vector<double>& coeffs) const {
+    const int n = m_finitizationOrder;
+    ScratchBuffer<double> a(n + 1);
+    if (x < 0 || x > n || !seriesConstants(a.data()))
+        return false;
+
+    coeffs.assign(n + 1, 0.0);
+    double c = 1.0;                              // binomial(j, x), starting at j = x
+    for (int j = x; j <= n; ++j) {
+        coeffs[j] = ((j - x) & 1) ? -c * a[j] : c * a[j];
+        c = c * (j + 1) / (j + 1 - x);
+    }
+    return true;
+}
+
+bool Finitization::numericProbs(double theta, double* out) const {
+    const int n = m_finitizationOrder;
+    ScratchBuffer<double> b(n + 1);
+
+    if (s_precision == EvaluationPrecision::DOUBLE_DOUBLE) {
+        ScratchBuffer<DoubleDouble> bb(n + 1);
+        if (!seriesCoefficients(theta, bb.data())) {
+            if (!seriesCoefficients(theta, b.data()))
+                return false;
+            for (int j = 0; j <= n; ++j)
+                bb[j] = DoubleDouble(b[j]);
+        }
+        for (int x = 0; x <= n; ++x) {
+            DoubleDouble sum;
+            DoubleDouble c(1.0);                 // binomial(j, x), exact up to 2^106
+            for (int j = x; j <= n; ++j) {
+                const DoubleDouble term = c * bb[j];
+                sum = ((j - x) & 1) ? sum - term : sum + term;
+                c = c * DoubleDouble(j + 1) / DoubleDouble(j + 1 - x);
+            }
+            out[x] = sum.toDouble();
+            if (!std::isfinite(out[x]))
+                return false;
+        }
+        return true;
+    }
+
+    if (!seriesCoefficients(theta, b.data()))
+        return false;
+    for (int x = 0; x <= n; ++x) {
+        double sum = 0.0, comp = 0.0;
+        double c = 1.0;                          // binomial(j, x), starting at j = x
+        for (int j = x; j <= n; ++j) {
+            compensatedAdd(sum, comp, ((j - x) & 1) ? -c * b[j] : c * b[j]);
+            c = c * (j + 1) / (j + 1 - x);
+        }
+        out[x] = sum + comp;
+        if (!std::isfinite(out[x]))
+            return false;
+    }
+    return true;
+}
+
+void Finitization::setEngine(int engine) {
+    if (engine < EvaluationEngine::AUTO || engine > EvaluationEngine::SYMBOLIC)
+        stop("Unknown evaluation engine %d.", engine);
+    s_engine = engine;
+}
+
+int Finitization::getEngine() {
+    return s_engine;
+}
+
+void Finitization::setPrecision(int precision) {
+    if (precision < EvaluationPrecision::DOUBLE || precision > EvaluationPrecision::DOUBLE_DOUBLE)
+        stop("Unknown evaluation precision %d.", precision);
+    s_precision = precision;
+}
+
+int Finitization::getPrecision() {
+    return s_precision;
+}
+
+bool Finitization::probabilities(double theta, double* out) {
+    {
+        FINITIZATION_TIMER(Instrumentation::NUMERIC);
+        if (probabilities(theta, nullptr, out))
+            return true;
+    }
+    if (s_engine != EvaluationEngine::AUTO && s_engine != EvaluationEngine::TEMPLATE)
+        return false;
+    std::shared_ptr<const PmfTemplate> tpl = FinitizationCache::instance().getTemplate(*this);
+    if (!tpl)
+        return false;
+    FINITIZATION_TIMER(Instrumentation::NUMERIC);
+    return probabilities(theta, tpl.get(), out);
+}
+
+bool Finitization::probabilities(double theta, const PmfTemplate* tpl, double* out) const {
+    bool numeric = false;
+    if (s_engine == EvaluationEngine::AUTO || s_engine == EvaluationEngine::SERIES)
+        numeric = numericProbs(theta, out);
+
+    if (!numeric && tpl && (s_engine == EvaluationEngine::AUTO || s_engine == EvaluationEngine::TEMPLATE))
+        numeric = tpl->evaluate(theta, out, s_precision == EvaluationPrecision::DOUBLE_DOUBLE);
+
+    if (!numeric)
+        return false;
+    for (int i = 0; i <= m_finitizationOrder; ++i)
+        out[i] = cleanProbability(out[i]);
+    return true;
+}
+
+bool Finitization::needsTemplate() const {
+    if (s_engine == EvaluationEngine::TEMPLATE)
+        return true;
+    if (s_engine != EvaluationEngine::AUTO)
+        return false;
+    ScratchBuffer<double> b(m_finitizationOrder + 1);
+    return !seriesCoefficients(m_theta, b.data());
+}
+
+void Finitization::computeProbs() {
+    const int K = m_finitizationOrder + 1;
+
+    if (!probabilities(m_theta, m_dprobs)) {
+        // The PMF compiled once per family and order; the symbolic path for what it cannot evaluate
+        std::shared_ptr<const std::vector<PmfProgram> > kernel = FinitizationCache::instance().getKernel(*this);
+        const bool extended = s_precision == EvaluationPrecision::DOUBLE_DOUBLE;
+        for (int i = 0; i < K; ++i) {
+            double p = std::numeric_limits<double>::quiet_NaN();
+            if (kernel) {
+                FINITIZATION_TIMER(Instrumentation::EVALUATION);
+                p = (*kernel)[i].evaluate(m_theta, extended);
+            }
+            m_dprobs[i] = std::isfinite(p) ? cleanProbability(p) : fin_pdf(i);
+        }
+    }
+
+    // Initialize internal sampling structure with computed probabilities
+    setProbs(m_dprobs);
+
+    // Lower and upper tail sums, accumulated from each end so that neither tail loses accuracy
+    double sum = 0.0, comp = 0.0;
+    for (int i = 0; i < K; ++i) {
+        compensatedAdd(sum, comp, m_dprobs[i]);
+        m_lowerCdf[i] = sum + comp;
+    }
+    sum = comp = 0.0;
+    for (int i = K - 1; i >= 0; --i) {
+        m_upperCdf[i] = sum + comp;
+        compensatedAdd(sum, comp, m_dprobs[i]);
+    }
+
+    // Mark setup as completed
+    m_finish = true;
+}
+
+double Finitization::cdf(int x, bool lowerTail, bool logP) const {
+    const int n = m_finitizationOrder;
+    double value;
+    if (x < 0)
+        value = lowerTail ? 0.0 : m_lowerCdf[n];
+    else if (x >= n)
+        value = lowerTail ? m_lowerCdf[n] : 0.0;
+    else
+        value = lowerTail ? m_lowerCdf[x] : m_upperCdf[x];
+    return logP ? std::log(value) : value;
+}
+
+int Finitization::quantile(double p, bool lowerTail, bool logP) const {
+    if (std::isnan(p))
+        return NA_INTEGER;
+    if (logP)
+        p = std::exp(p);
+
+    // Smallest x with P(X <= x) >= p, or with P(X > x) <= p for the upper tail.
+    // P(X <= n) is taken as 1, so that p = 1 maps to n despite rounding.
+    int lo = 0, hi = m_finitizationOrder;
+    while (lo < hi) {
+        const int mid = (lo + hi) >> 1;
+        if (lowerTail ? (m_lowerCdf[mid] >= p) : (m_upperCdf[mid] <= p))
+            hi = mid;
+        else
+            lo = mid + 1;
     }
+    return lo;
 }
 
@@ -9,6 +9,13 @@
 #include <ginac/ginac.h>
 #include <cfloat>   // DBL_EPSILON
 #include <cmath>    // std::fabs
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "SamplerType.h"
+#include "ValueStream.h"
+#include "Arena.h"
+#include "PmfProgram.h"
 
 
 using namespace std;
@@ -18,6 +25,11 @@ using namespace GiNaC;
 #ifndef FINITIZATION_H_
 #define FINITIZATION_H_
 
+class PmfTemplate;
+class DoubleDouble;
+class CompactAliasTable;
+struct SamplingTables;
+
 /**
  * @class Finitization
  * @brief Abstract base class for finitized probability distributions.
@@ -57,22 +69,332 @@ public:
     string pdfToString(int val, bool tolatex = false);
 
     /**
-     * @brief Generates random samples using the alias method.
+     * @brief Returns the string or LaTeX representation of a symbolic PDF.
+     *
+     * @param pdf A symbolic PDF, e.g. an element of symbolicPmfs().
+     * @param tolatex Whether to use LaTeX output format.
+     */
+    static string pdfToString(const ex& pdf, bool tolatex = false);
+
+    /**
+     * @brief Returns the symbolic PDFs for x = 0, ..., n.
+     *
+     * The PDFs are computed in a single sweep of n derivatives of the finitized
+     * series, which are kept in the derivative cache.
+     */
+    std::vector<ex> symbolicPmfs();
+
+    /**
+     * @brief Generates random samples with R's uniform generator.
      *
      * @param no Number of values to generate.
+     * @param sampler The sampling method (see SamplerType).
      * @return An IntegerVector containing the sampled values.
      */
-    IntegerVector rvalues(int no);
+    IntegerVector rvalues(int no, int sampler = SamplerType::AUTO);
+
+    /**
+     * @brief Generates random samples on several threads.
+     *
+     * The draws are split into blocks of SAMPLE_BLOCK values. Block b uses its own
+     * xoshiro256++ stream, obtained by b jumps of a generator seeded from R's RNG,
+     * and the threads only read the sampling tables. The result is reproducible with
+     * set.seed() and does not depend on the number of threads.
+     *
+     * @param no Number of values to generate.
+     * @param nthreads Number of threads (<= 0 uses all the hardware threads).
+     * @param sampler The sampling method (see SamplerType).
+     * @return An IntegerVector containing the sampled values.
+     */
+    IntegerVector rvalues(int no, int nthreads, int sampler);
+
+    /**
+     * @brief Starts a stream of random values seeded from R's RNG.
+     *
+     * The stream gives the same values as rvalues(no, nthreads, sampler) called
+     * after the same set.seed().
+     */
+    static ValueStream newStream();
+
+    /**
+     * @brief Draws a 64-bit seed from R's RNG, so set.seed() makes its use reproducible.
+     */
+    static uint64_t newSeed();
+
+    /**
+     * @brief Writes the next \p count values of a stream to a caller-supplied buffer.
+     *
+     * The values continue the sequence where the previous call stopped, so a long
+     * sequence can be generated in chunks of any size at constant memory. The
+     * threads only read the sampling tables and do not call the R API.
+     *
+     * @param stream The stream, advanced past the generated values.
+     * @param out The buffer receiving \p count values.
+     * @param count Number of values to generate.
+     * @param nthreads Number of threads (<= 0 uses all the hardware threads).
+     * @param sampler The sampling method (see SamplerType).
+     */
+    void stream(ValueStream& stream, int* out, std::size_t count, int nthreads, int sampler);
+
+    /**
+     * @brief Resolves the sampling method used for a support of K points.
+     *
+     * An explicit method is returned unchanged. For SamplerType::AUTO, supports
+     * larger than 8 points use the alias method and smaller ones the ladder method.
+     * SamplerType::CALIBRATED differs for the smaller supports: the alias, ladder
+     * and inversion methods are timed once per K and the fastest is kept, so the
+     * choice (and the values drawn for a seed) may change from run to run.
+     *
+     * @param sampler The requested method (see SamplerType).
+     * @param K The number of support points.
+     */
+    static int selectSampler(int sampler, int K);
+
+    /**
+     * @brief Copies the tables of the alias method.
+     *
+     * @param cutoff Receives the n + 1 cutoffs.
+     * @param alias Receives the n + 1 alias indices.
+     */
+    void aliasTables(double* cutoff, int* alias) const;
+
+    static const int SAMPLE_BLOCK = ValueStream::BLOCK;   ///< Number of draws per independent stream
 
     /**
      * @brief Computes the numeric value of the finitized PDF.
      *
+     * Once the tables are set, the stored probability is returned. Otherwise the symbolic
+     * PMF at \p val is compiled once into a PmfProgram and evaluated in the selected
+     * precision; GiNaC evaluates the expressions that cannot be compiled.
+     *
      * @param val Value of the variable to evaluate.
      * @return A double representing the finitized PDF value.
      */
     double fin_pdf(int val);
 
+    /**
+     * @brief Extends the distribution to a higher finitization order.
+     *
+     * The series expansion and the cached derivatives of the symbolic PMF are
+     * extended with the new terms of the series rather than recomputed, then the
+     * probabilities, the tail sums and the sampling tables are rebuilt for the new
+     * order. Growing an object step by step from order 1 to N thus costs about as
+     * much as building it at order N. Nothing is done if \p order is not larger
+     * than the current order.
+     *
+     * @param order The new finitization order.
+     */
+    void extendOrder(int order);
+
+    /**
+     * @brief Returns the finitized CDF, P(X <= x), or the upper tail, P(X > x).
+     *
+     * Both tails are read from arrays accumulated with compensated summation when
+     * the probabilities are computed; the upper tail is summed directly, not
+     * obtained as 1 - P(X <= x), so small upper-tail probabilities keep their
+     * relative accuracy, also on the log scale.
+     *
+     * @param x Value of the variable.
+     * @param lowerTail If true, P(X <= x) is returned, otherwise P(X > x).
+     * @param logP If true, the logarithm of the probability is returned.
+     */
+    double cdf(int x, bool lowerTail = true, bool logP = false) const;
+
+    /**
+     * @brief Returns the quantile of a probability by binary search in the cached CDF.
+     *
+     * The quantile is the smallest x with P(X <= x) >= p (lower tail) or with
+     * P(X > x) <= p (upper tail).
+     *
+     * @param p The probability, in [0, 1] (or its logarithm if \p logP is true).
+     * @param lowerTail If true, \p p is a lower-tail probability, otherwise an upper-tail one.
+     * @param logP If true, \p p is given on the log scale.
+     * @return The quantile, or NA_INTEGER if \p p is NaN.
+     */
+    int quantile(double p, bool lowerTail = true, bool logP = false) const;
+
+    /**
+     * @brief Returns the distribution type (see DistributionType).
+     */
+    virtual int getType() const = 0;
+
+    /**
+     * @brief Returns a copy of the distribution, with its symbolic state and its tables.
+     *
+     * The GiNaC expressions are reference-counted, so the copy shares the series and
+     * the cached derivatives until one of the objects modifies them.
+     */
+    virtual std::unique_ptr<Finitization> clone() const = 0;
+
+    /**
+     * @brief Returns the structural (integer) parameter of the distribution.
+     *
+     * This is the number of trials N for the Binomial distribution and k for the
+     * Negative Binomial distribution. One-parameter distributions return 0.
+     */
+    virtual int getSizeParameter() const;
+
+    /**
+     * @brief Returns the finitization order.
+     */
+    int getOrder() const;
+
+    /**
+     * @brief Returns the value of the distribution parameter.
+     */
+    double getTheta() const;
+
+    /**
+     * @brief Returns the symbol of the distribution parameter in the symbolic PDFs.
+     */
+    const symbol& getParameterSymbol() const;
+
+    /**
+     * @brief Builds the parameter-independent numeric template of the PMF.
+     *
+     * Derives the symbolic PMF for x = 0, ..., n and stores it as rational functions
+     * of the distribution parameter. The construction stops at the first PMF which is
+     * not rational in the parameter (e.g. the Logarithmic distribution), in which case
+     * the returned template is not numeric.
+     *
+     * @return The template of the PMF.
+     */
+    std::shared_ptr<PmfTemplate> buildTemplate();
+
+    /**
+     * @brief Compiles the symbolic PMF of x = 0, ..., n into numeric kernels.
+     *
+     * The kernels do not depend on the value of the parameter, so they are shared
+     * by all the distributions of the same family and order (see
+     * FinitizationCache::getKernel()).
+     *
+     * @return The n + 1 compiled programs, or an empty vector if a PMF cannot be compiled.
+     */
+    std::shared_ptr<std::vector<PmfProgram> > buildKernel();
+
+    /**
+     * @brief Computes the finitized probabilities from the closed-form series coefficients.
+     *
+     * The x-th derivative of the truncated series evaluated at \f$ -\theta \f$ is a finite
+     * sum, so the PMF is
+     * \f[
+     *     f(x) = \sum_{j=x}^{n} (-1)^{j-x} \binom{j}{x} b_j(\theta),
+     * \f]
+     * where \f$ b_j \f$ are the scaled series coefficients returned by seriesCoefficients().
+     * The sums use compensated (Neumaier) summation, or double-double arithmetic on
+     * double-double coefficients when that precision is selected. No GiNaC call is made.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param out Output array of n+1 raw (unclamped) PMF values.
+     * @return false if the distribution has no closed-form coefficients or a value is not finite.
+     */
+    bool numericProbs(double theta, double* out) const;
+
+    /**
+     * @brief Computes the finitized probabilities for another value of the parameter, without GiNaC.
+     *
+     * Uses the closed-form series coefficients or the PMF template of the distribution,
+     * as allowed by the selected evaluation engine, and applies the same clamping as fin_pdf().
+     * The distribution itself is not modified, so one object can evaluate a whole grid of
+     * parameter values of its family.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param out Output array of n+1 probabilities.
+     * @return false if no numeric method is available; the symbolic path must be used then.
+     */
+    bool probabilities(double theta, double* out);
+
+    /**
+     * @brief Thread-safe variant of probabilities() with a template fetched beforehand.
+     *
+     * Makes no GiNaC, R, cache or instrumentation call, so it can run on worker threads;
+     * the callers time it as the numeric phase.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param tpl The PMF template of the family, or nullptr to use only the series engine.
+     * @param out Output array of n+1 probabilities.
+     * @return false if no numeric method is available.
+     */
+    bool probabilities(double theta, const PmfTemplate* tpl, double* out) const;
+
+    /**
+     * @brief Tells if the selected engine may need the PMF template of this distribution.
+     *
+     * True for the template engine, and for the automatic engine when the distribution has no
+     * closed-form series coefficients at its own parameter value.
+     */
+    bool needsTemplate() const;
+
+    /**
+     * @brief Coefficients of the PMF at x as a polynomial in the series argument.
+     *
+     * When the scaled series coefficients have the form \f$ b_j = a_j u^j \f$, with constant
+     * \f$ a_j \f$ and \f$ u \f$ = seriesArgument(theta), the PMF at x is the polynomial
+     * \f$ \sum_{j=x}^{n} (-1)^{j-x} \binom{j}{x} a_j u^j \f$ in u.
+     *
+     * @param x Value of the variable, in {0, ..., n}.
+     * @param coeffs Output coefficients, in increasing powers of u.
+     * @return false if the distribution has no constant series coefficients.
+     */
+    bool pmfPolynomial(int x, std::vector<double>& coeffs) const;
+
+    /**
+     * @brief The variable u in which the series coefficients are \f$ a_j u^j \f$ (theta by default).
+     */
+    virtual double seriesArgument(double theta) const;
+
+    /**
+     * @brief The inverse of seriesArgument().
+     */
+    virtual double seriesParameter(double u) const;
+
+    /**
+     * @brief Selects the method used to compute the finitized probabilities (see EvaluationEngine).
+     */
+    static void setEngine(int engine);
+
+    /**
+     * @brief Returns the method used to compute the finitized probabilities (see EvaluationEngine).
+     */
+    static int getEngine();
+
+    /**
+     * @brief Selects the arithmetic of the numeric evaluation of the PMF (see EvaluationPrecision).
+     */
+    static void setPrecision(int precision);
+
+    /**
+     * @brief Returns the arithmetic of the numeric evaluation of the PMF (see EvaluationPrecision).
+     */
+    static int getPrecision();
+
 protected:
+    /**
+     * @brief Copy constructor used by clone(); the copy owns new tables with the same contents.
+     */
+    Finitization(const Finitization& other);
+
+    /**
+     * @brief Computes the finitized probabilities and initializes the sampling tables.
+     *
+     * Fills m_dprobs for x = 0, ..., n with probabilities(); the
+     * symbolic path is used when no numeric method is available. Called by the
+     * constructors of the derived classes once the symbols and the parameter are set.
+     */
+    void computeProbs();
+
+    /**
+     * @brief Allocates the arrays of size n+1 (probabilities, tail sums and sampling tables).
+     */
+    void allocateTables();
+
+    /**
+     * @brief Releases the arrays allocated by allocateTables().
+     *
+     * The arena keeps its block for the next allocateTables() and frees it on destruction.
+     */
+    void releaseTables();
+
     /**
      * @brief Initializes alias method tables from a probability vector.
      *
@@ -83,6 +405,15 @@ protected:
      */
     void setProbs(double *probs);
 
+    /**
+     * @brief Returns the sampling tables used by a sampling method.
+     *
+     * The compact alias tables are built from the alias tables on first use.
+     *
+     * @param sampler A sampling method resolved by selectSampler().
+     */
+    SamplingTables samplingTables(int sampler);
+
     /**
      * @brief Computes the finitized form of the generating function.
      *
@@ -124,12 +455,52 @@ protected:
      */
     virtual ex ntsd_base(symbol x, symbol theta) = 0;
 
+    /**
+     * @brief Scaled coefficients of the truncated native series, computed numerically.
+     *
+     * If \f$ a_j(\theta) \f$ is the coefficient of \f$ x^j \f$ in the series of `ntsd_base()`,
+     * this method fills \f$ b_j = a_j(\theta) \theta^j \f$ for j = 0, ..., n. Derived classes
+     * with a known closed form override it; the default implementation returns false and
+     * the probabilities are then computed from the PMF template or symbolically.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param b Output array of n+1 coefficients.
+     * @return true if the coefficients were computed.
+     */
+    virtual bool seriesCoefficients(double theta, double* b) const;
+
+    /**
+     * @brief The coefficients of seriesCoefficients() in double-double precision.
+     *
+     * Used by numericProbs() when that precision is selected, since the alternating sums
+     * cannot be more accurate than their terms. The default implementation returns false
+     * and the double precision coefficients are used then.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param b Output array of n+1 coefficients.
+     * @return true if the coefficients were computed.
+     */
+    virtual bool seriesCoefficients(double theta, DoubleDouble* b) const;
+
+    /**
+     * @brief Constant parts \f$ a_j \f$ of the scaled series coefficients \f$ b_j = a_j u^j \f$.
+     *
+     * Derived classes whose PMF is a polynomial in seriesArgument() override it; the default
+     * implementation returns false.
+     *
+     * @param a Output array of n+1 constants.
+     * @return true if the constants were computed.
+     */
+    virtual bool seriesConstants(double* a) const;
+
     int m_finitizationOrder;        ///< Order of the finitization (number of moments preserved)
     double m_theta;                 ///< Parameter value used in the distribution
     symbol m_paramSymb;            ///< Symbol representing the distribution parameter (e.g., p, theta)
     symbol m_x;                    ///< Symbol representing the random variable x
     double* m_dprobs;              ///< Pointer to numerical probabilities for sampling
     bool m_finish;                 ///< Used for internal state tracking
+    double* m_lowerCdf;            ///< P(X <= x), compensated sums of m_dprobs
+    double* m_upperCdf;            ///< P(X > x), compensated sums of m_dprobs from the top
 
 private:
 //    std::uniform_real_distribution<double> m_unif_double_distribution; ///< Uniform real generator
@@ -138,13 +509,20 @@ private:
 
     int* m_alias;               ///< Alias table for sampling
     double* m_prob;             ///< Probability table for sampling
+    double* m_cdf;              ///< CDF for sampling by inversion
+    double* m_ladderCdf;        ///< CDF of the support sorted by decreasing probability
+    int* m_ladderIdx;           ///< Support values in the order of m_ladderCdf
+    std::unique_ptr<CompactAliasTable> m_compact; ///< Packed alias tables, built on demand
     int* m_values;              ///< Support values associated with the distribution
+    Arena m_arena;              ///< Owns the probabilities and the sampling tables
 
     bool m_ntsfFirstTime;       ///< Used to delay computation of ntsf form
     ex m_ntsfSymb;              ///< Cached symbolic form of the normalized truncated series
     std::unordered_map<int, ex> m_cache; ///< Cache of symbolic evaluations at specific values
-    double* m_pmf_small;   // normalized PMF cache for tiny K (<=4)
-    bool    m_smallK;       // activates macOS tiny-K ladder
+    std::unordered_map<int, PmfProgram> m_programs; ///< Compiled symbolic PMFs, by value of the variable
+
+    static int s_engine;    ///< Method used to compute the probabilities (see EvaluationEngine)
+    static int s_precision; ///< Arithmetic of the numeric evaluation (see EvaluationPrecision)
 };
 
 #endif /* FINITIZATION_H_ */
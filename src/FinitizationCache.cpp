@@ -0,0 +1,146 @@
+/*
+ * FinitizationCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "FinitizationCache.h"
+#include "FinitizedLogarithmicDistribution.h"
+#include "FinitizedPoissonDistribution.h"
+#include "FinitizedBinomialDistribution.h"
+#include "FinitizedNegativeBinomialDistribution.h"
+#include "FinitizedCustomDistribution.h"
+#include "DistributionType.h"
+#include "Instrumentation.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+using namespace std;
+
+DistributionKey::DistributionKey(int dtype_, int n_, double theta_, int size_):
+    dtype(dtype_), n(n_), theta(theta_ == 0.0 ? 0.0 : theta_), size(size_) {
+}
+
+bool DistributionKey::operator==(const DistributionKey& other) const {
+    return dtype == other.dtype && n == other.n && size == other.size &&
+        std::memcmp(&theta, &other.theta, sizeof(double)) == 0;
+}
+
+size_t DistributionKeyHash::operator()(const DistributionKey& key) const {
+    uint64_t bits;
+    std::memcpy(&bits, &key.theta, sizeof(double));
+    size_t h = std::hash<uint64_t>()(bits);
+    h ^= std::hash<int>()(key.dtype) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(key.n) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(key.size) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+std::unique_ptr<Finitization> newFinitization(const DistributionKey& key) {
+    switch(key.dtype) {
+    case DistributionType::POISSON:
+        return std::unique_ptr<Finitization>(new FinitizedPoissonDistribution(key.n, key.theta));
+    case DistributionType::LOGARITHMIC:
+        return std::unique_ptr<Finitization>(new FinitizedLogarithmicDistribution(key.n, key.theta));
+    case DistributionType::BINOMIAL:
+        return std::unique_ptr<Finitization>(new FinitizedBinomialDistribution(key.n, key.theta, key.size));
+    case DistributionType::NEGATIVEBINOMIAL:
+        return std::unique_ptr<Finitization>(new FinitizedNegativeBinomialDistribution(key.n, key.theta, key.size));
+    case DistributionType::CUSTOM:
+        return std::unique_ptr<Finitization>(new FinitizedCustomDistribution(key.n, key.theta, key.size));
+    default:
+        return std::unique_ptr<Finitization>();
+    }
+}
+
+FinitizationCache::FinitizationCache(): m_cache(DEFAULT_CAPACITY), m_templates(DEFAULT_CAPACITY),
+    m_kernels(DEFAULT_CAPACITY) {
+}
+
+FinitizationCache& FinitizationCache::instance() {
+    static FinitizationCache cache;
+    return cache;
+}
+
+std::shared_ptr<Finitization> FinitizationCache::get(const DistributionKey& key) {
+    std::shared_ptr<Finitization> f;
+    if (m_cache.find(key, f)) {
+        FINITIZATION_COUNT(Instrumentation::CACHE_HITS, 1.0);
+        return f;
+    }
+    FINITIZATION_COUNT(Instrumentation::CACHE_MISSES, 1.0);
+
+    // A copy of the same distribution of the previous order (an increasing sweep over n) is extended,
+    // not rebuilt; both orders stay in the cache
+    const DistributionKey previous(key.dtype, key.n - 1, key.theta, key.size);
+    std::shared_ptr<Finitization> lower;
+    if (key.n > 1 && m_cache.peek(previous, lower)) {
+        f = lower->clone();
+        f->extendOrder(key.n);
+        m_cache.insert(key, f);
+        return f;
+    }
+
+    f = newFinitization(key);
+    if (f)
+        m_cache.insert(key, f);
+    return f;
+}
+
+std::shared_ptr<const PmfTemplate> FinitizationCache::getTemplate(Finitization& f) {
+    const DistributionKey key(f.getType(), f.getOrder(), 0.0, f.getSizeParameter());
+    std::shared_ptr<const PmfTemplate> tpl;
+    if (!m_templates.find(key, tpl)) {
+        tpl = f.buildTemplate();
+        m_templates.insert(key, tpl);
+    }
+    if (!tpl->isNumeric())
+        tpl.reset();
+    return tpl;
+}
+
+std::shared_ptr<const std::vector<PmfProgram> > FinitizationCache::getKernel(Finitization& f) {
+    const DistributionKey key(f.getType(), f.getOrder(), 0.0, f.getSizeParameter());
+    std::shared_ptr<const std::vector<PmfProgram> > kernel;
+    if (!m_kernels.find(key, kernel)) {
+        kernel = f.buildKernel();
+        m_kernels.insert(key, kernel);
+    }
+    if (kernel->empty())
+        kernel.reset();
+    return kernel;
+}
+
+void FinitizationCache::clear() {
+    m_cache.clear();
+    m_templates.clear();
+    m_kernels.clear();
+}
+
+void FinitizationCache::setCapacity(size_t capacity) {
+    m_cache.setCapacity(capacity);
+    m_templates.setCapacity(capacity);
+    m_kernels.setCapacity(capacity);
+}
+
+size_t FinitizationCache::size() const {
+    return m_cache.size();
+}
+
+size_t FinitizationCache::capacity() const {
+    return m_cache.capacity();
+}
+
+size_t FinitizationCache::hits() const {
+    return m_cache.hits();
+}
+
+size_t FinitizationCache::misses() const {
+    return m_cache.misses();
+}
+
+size_t FinitizationCache::templates() const {
+    return m_templates.size();
+}
@@ -0,0 +1,145 @@
+/*
+ * FinitizationCache.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef FINITIZATIONCACHE_H_
+#define FINITIZATIONCACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include "Finitization.h"
+#include "LruCache.h"
+#include "PmfTemplate.h"
+
+/**
+ * @struct DistributionKey
+ * @brief Identifies a finitized distribution: type, order and parameters.
+ *
+ * \c size holds the second (integer) parameter of the distribution, i.e. the
+ * number of trials N for the Binomial distribution and k for the Negative
+ * Binomial distribution. It is 0 for the one-parameter distributions.
+ */
+struct DistributionKey {
+    int dtype;      ///< Distribution type (see DistributionType)
+    int n;          ///< Finitization order
+    double theta;   ///< Distribution parameter (theta, p or q)
+    int size;       ///< N (Binomial) or k (Negative Binomial), 0 otherwise
+
+    DistributionKey(int dtype_ = 0, int n_ = 0, double theta_ = 0.0, int size_ = 0);
+
+    /**
+     * @brief Equality based on the bit pattern of \c theta, so that NaN keys are well behaved.
+     */
+    bool operator==(const DistributionKey& other) const;
+};
+
+/**
+ * @struct DistributionKeyHash
+ * @brief Hash functor for DistributionKey.
+ */
+struct DistributionKeyHash {
+    std::size_t operator()(const DistributionKey& key) const;
+};
+
+/**
+ * @brief Constructs a new finitized distribution object described by a key.
+ *
+ * The object is owned by the returned pointer as soon as it is built, so nothing leaks
+ * when a later step throws.
+ *
+ * @param key The distribution type, order and parameters.
+ * @return The new object, or an empty pointer if the distribution type is unsupported.
+ */
+std::unique_ptr<Finitization> newFinitization(const DistributionKey& key);
+
+/**
+ * @class FinitizationCache
+ * @brief Process-wide LRU registry of constructed finitized distributions.
+ *
+ * Building a finitized distribution requires a symbolic series expansion and
+ * n symbolic derivatives. The exported entry points ask this registry for an
+ * object instead of building one, so repeated calls with the same type, order
+ * and parameters reuse the same instance.
+ *
+ * The registry also keeps the numeric PMF templates (see PmfTemplate), keyed by
+ * distribution type, order and structural parameter only: a distribution with a
+ * new parameter value is built by evaluating the template of its family instead
+ * of repeating the symbolic derivation. The registry is only accessed from the R
+ * main thread.
+ */
+class FinitizationCache {
+
+public:
+    static const std::size_t DEFAULT_CAPACITY = 128;   ///< Initial number of cached objects
+
+    /**
+     * @brief Returns the single instance of the registry.
+     */
+    static FinitizationCache& instance();
+
+    /**
+     * @brief Returns the distribution described by \p key, building it on a miss.
+     *
+     * On a miss, if the distribution with the same type and parameters and the
+     * previous order is cached, a copy of it is extended (see Finitization::extendOrder())
+     * instead of building a new object; the distribution of the previous order stays cached.
+     *
+     * @param key The distribution type, order and parameters.
+     * @return A shared pointer to the distribution, empty if the type is unsupported.
+     */
+    std::shared_ptr<Finitization> get(const DistributionKey& key);
+
+    /**
+     * @brief Returns the numeric PMF template of the family of \p f.
+     *
+     * On a miss the template is derived from the symbolic PMF of \p f and stored,
+     * also when it turns out not to be numeric, so that the derivation is attempted
+     * only once per family.
+     *
+     * @param f A distribution whose symbols and parameters are set.
+     * @return The template, or an empty pointer if the PMF is not rational in the parameter.
+     */
+    std::shared_ptr<const PmfTemplate> getTemplate(Finitization& f);
+
+    /**
+     * @brief Returns the compiled PMF of the family of \p f (see Finitization::buildKernel()).
+     *
+     * The kernel is compiled on the first request for a family and order and kept
+     * with the templates, also when the PMF cannot be compiled, so that the
+     * compilation is attempted only once.
+     *
+     * @param f A distribution whose symbols and parameters are set.
+     * @return The n + 1 programs, or an empty pointer if the PMF cannot be compiled.
+     */
+    std::shared_ptr<const std::vector<PmfProgram> > getKernel(Finitization& f);
+
+    /**
+     * @brief Drops all cached objects and templates and resets the hit/miss counters.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the maximum number of cached objects and templates (0 disables caching).
+     */
+    void setCapacity(std::size_t capacity);
+
+    std::size_t size() const;       ///< Number of cached objects
+    std::size_t capacity() const;   ///< Maximum number of cached objects
+    std::size_t hits() const;       ///< Number of lookups answered from the cache
+    std::size_t misses() const;     ///< Number of lookups that built a new object
+    std::size_t templates() const;  ///< Number of cached PMF templates
+
+private:
+    FinitizationCache();
+    FinitizationCache(const FinitizationCache&);
+    FinitizationCache& operator=(const FinitizationCache&);
+
+    LruCache<DistributionKey, std::shared_ptr<Finitization>, DistributionKeyHash> m_cache;
+    LruCache<DistributionKey, std::shared_ptr<const PmfTemplate>, DistributionKeyHash> m_templates;
+    LruCache<DistributionKey, std::shared_ptr<const std::vector<PmfProgram> >, DistributionKeyHash> m_kernels;
+};
+
+#endif /* FINITIZATIONCACHE_H_ */
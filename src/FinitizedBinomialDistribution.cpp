@@ -5,6 +5,8 @@
  *      Author: Bogdan Oancea
  */
 #include "FinitizedBinomialDistribution.h"
+#include "DistributionType.h"
+#include "DoubleDouble.h"
 #include <ginac/ginac.h>
 
 using namespace std;
@@ -13,18 +15,9 @@ FinitizedBinomialDistribution::FinitizedBinomialDistribution(int n, double p, in
     m_theta = p;                          // Set the success probability
     m_paramSymb = symbol("p");           // Symbol for the probability parameter
     m_x = symbol("x");                   // Symbol for the outcome variable
-    m_dprobs = new double[n + 1];        // Allocate memory for finitized probabilities
 
-    // Compute finitized PDF values for x = 0 to n and store in m_dprobs
-    for (int i = 0; i <= n; ++i) {
-        m_dprobs[i] = fin_pdf(i);
-    }
-
-    // Initialize the internal alias sampling table
-    setProbs(m_dprobs);
-
-    // Mark that initialization has finished
-    m_finish = true;
+    // Compute finitized PDF values for x = 0 to n and initialize the alias sampling table
+    computeProbs();
 }
 
 FinitizedBinomialDistribution::~FinitizedBinomialDistribution() {
@@ -35,3 +28,35 @@ ex FinitizedBinomialDistribution::ntsd_base(symbol x, symbol theta){
     return pow((1 + x), m_N);
 }
 
+int FinitizedBinomialDistribution::getType() const {
+    return DistributionType::BINOMIAL;
+}
+
+std::unique_ptr<Finitization> FinitizedBinomialDistribution::clone() const {
+    return std::unique_ptr<Finitization>(new FinitizedBinomialDistribution(*this));
+}
+
+int FinitizedBinomialDistribution::getSizeParameter() const {
+    return m_N;
+}
+
+bool FinitizedBinomialDistribution::seriesCoefficients(double theta, double* b) const {
+    b[0] = 1.0;
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        b[j] = (j > m_N) ? 0.0 : b[j - 1] * (m_N - j + 1) / j * theta;
+    return true;
+}
+
+bool FinitizedBinomialDistribution::seriesCoefficients(double theta, DoubleDouble* b) const {
+    b[0] = DoubleDouble(1.0);
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        b[j] = (j > m_N) ? DoubleDouble() : b[j - 1] * DoubleDouble(m_N - j + 1) / DoubleDouble(j) * DoubleDouble(theta);
+    return true;
+}
+
+bool FinitizedBinomialDistribution::seriesConstants(double* a) const {
+    a[0] = 1.0;
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        a[j] = (j > m_N) ? 0.0 : a[j - 1] * (m_N - j + 1) / j;
+    return true;
+}
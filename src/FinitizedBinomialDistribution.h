@@ -46,6 +46,18 @@ public:
     */
     virtual ~FinitizedBinomialDistribution();
 
+    /**
+     * @brief Returns the distribution type (DistributionType::BINOMIAL).
+     */
+    int getType() const override;
+
+    std::unique_ptr<Finitization> clone() const override;
+
+    /**
+     * @brief Returns the number of trials N.
+     */
+    int getSizeParameter() const override;
+
 private:
     int m_N;  ///< Number of trials in the Binomial distribution
 
@@ -60,6 +72,17 @@ private:
      * @return GiNaC symbolic expression representing \f$ (1 + x)^N \f$.
      */
     ex ntsd_base(symbol x, symbol theta) override;
+
+    /**
+     * @brief Closed-form scaled series coefficients \f$ b_j = \binom{N}{j} p^j \f$ (0 for j > N).
+     */
+    bool seriesCoefficients(double theta, double* b) const override;
+    bool seriesCoefficients(double theta, DoubleDouble* b) const override;
+
+    /**
+     * @brief Constant series coefficients \f$ a_j = \binom{N}{j} \f$.
+     */
+    bool seriesConstants(double* a) const override;
 };
 
 #endif /* FINITIZEDBINOMIALDISTRIBUTION_H_ */
@@ -0,0 +1,45 @@
+/*
+ * FinitizedCustomDistribution.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+#include "FinitizedCustomDistribution.h"
+#include "FamilyRegistry.h"
+#include "DistributionType.h"
+#include <ginac/ginac.h>
+
+using namespace std;
+
+FinitizedCustomDistribution::FinitizedCustomDistribution(int n, double theta, int family): Finitization(n),
+    m_family(family), m_base(FamilyRegistry::instance().base(family)) {
+    m_theta = theta;                      // Store the parameter theta
+    m_paramSymb = symbol("theta");       // Symbol for theta used in symbolic expressions
+    m_x = symbol("x");                   // Symbol representing the discrete outcome variable
+
+    // Compute finitized PDF values for x = 0 to n and initialize the alias sampling table
+    computeProbs();
+}
+
+FinitizedCustomDistribution::~FinitizedCustomDistribution() {
+}
+
+ex FinitizedCustomDistribution::ntsd_base(symbol x, symbol theta) {
+    const FamilyRegistry& registry = FamilyRegistry::instance();
+    exmap symbols;
+    symbols[registry.variable()] = x;
+    symbols[registry.parameter()] = theta;
+    return m_base.subs(symbols);
+}
+
+int FinitizedCustomDistribution::getType() const {
+    return DistributionType::CUSTOM;
+}
+
+std::unique_ptr<Finitization> FinitizedCustomDistribution::clone() const {
+    return std::unique_ptr<Finitization>(new FinitizedCustomDistribution(*this));
+}
+
+int FinitizedCustomDistribution::getSizeParameter() const {
+    return m_family;
+}
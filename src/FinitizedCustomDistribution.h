@@ -0,0 +1,66 @@
+/*
+ * FinitizedCustomDistribution.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef FINITIZEDCUSTOMDISTRIBUTION_H_
+#define FINITIZEDCUSTOMDISTRIBUTION_H_
+
+#include "Finitization.h"
+#include <ginac/ginac.h>
+
+using namespace std;
+using namespace GiNaC;
+
+/**
+ * @class FinitizedCustomDistribution
+ * @brief Finitized distribution of a user-defined family (see FamilyRegistry).
+ *
+ * The native series is the one registered for the family, so no subclass is
+ * needed for a new distribution. There are no closed-form series coefficients:
+ * the probabilities come from the PMF template when the PMF is rational in the
+ * parameter, and from the compiled kernel of the family otherwise, both derived
+ * once per family and order.
+ */
+class FinitizedCustomDistribution : public Finitization {
+public:
+    /**
+     * @brief Constructor for a finitized distribution of a user-defined family.
+     *
+     * @param n     The finitization order (i.e., number of moments to preserve).
+     * @param theta The parameter of the distribution.
+     * @param family The identifier of the family in the FamilyRegistry.
+     * @throws Rcpp::exception if the family is not registered.
+     */
+    FinitizedCustomDistribution(int n, double theta, int family);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~FinitizedCustomDistribution();
+
+    /**
+     * @brief Returns the distribution type (DistributionType::CUSTOM).
+     */
+    int getType() const override;
+
+    std::unique_ptr<Finitization> clone() const override;
+
+    /**
+     * @brief Returns the identifier of the family.
+     */
+    int getSizeParameter() const override;
+
+private:
+    int m_family;   ///< Identifier of the family in the FamilyRegistry
+    ex m_base;      ///< Native series of the family, in the registry's symbols
+
+    /**
+     * @brief The registered native series \f$ G(1 + x / \theta) \f$, in the symbols \p x and \p theta.
+     */
+    ex ntsd_base(symbol x, symbol theta) override;
+};
+
+#endif /* FINITIZEDCUSTOMDISTRIBUTION_H_ */
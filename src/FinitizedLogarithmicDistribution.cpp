@@ -6,7 +6,10 @@
  */
 
 #include "FinitizedLogarithmicDistribution.h"
+#include "DistributionType.h"
+#include "DoubleDouble.h"
 #include <ginac/ginac.h>
+#include <cmath>
 
 
 
@@ -17,18 +20,8 @@ FinitizedLogarithmicDistribution::FinitizedLogarithmicDistribution(int n, double
     m_paramSymb = symbol("theta");     // Symbol for θ used in symbolic expressions
     m_x = symbol("x");                 // Symbol representing the outcome variable
 
-    m_dprobs = new double[n + 1];      // Allocate space for finitized probability values
-
-    // Compute finitized probabilities for all values from 0 to n
-    for (int i = 0; i <= n; ++i) {
-        m_dprobs[i] = fin_pdf(i);
-    }
-
-    // Initialize alias method structures for sampling
-    setProbs(m_dprobs);
-
-    // Mark initialization as complete
-    m_finish = true;
+    // Compute finitized PDF values for x = 0 to n and initialize the alias sampling table
+    computeProbs();
 }
 
 FinitizedLogarithmicDistribution::~FinitizedLogarithmicDistribution() {
@@ -39,8 +32,43 @@ ex FinitizedLogarithmicDistribution::ntsd_base(symbol x, symbol theta){
     return theta * log(1 - theta -x) / ((theta + x) * log(1-theta));
 }
 
+int FinitizedLogarithmicDistribution::getType() const {
+    return DistributionType::LOGARITHMIC;
+}
 
+std::unique_ptr<Finitization> FinitizedLogarithmicDistribution::clone() const {
+    return std::unique_ptr<Finitization>(new FinitizedLogarithmicDistribution(*this));
+}
 
+bool FinitizedLogarithmicDistribution::seriesCoefficients(double theta, double* b) const {
+    if (!(theta > 0.0 && theta < 1.0))
+        return false;
+    const double L = std::log1p(-theta);
+    const double r = theta / (1.0 - theta);
+    double rm = 1.0;                    // r^m
+    double S = L;
+    b[0] = 1.0;
+    for (int m = 1; m <= m_finitizationOrder; ++m) {
+        rm *= r;
+        S = -rm / m - S;
+        b[m] = S / L;
+    }
+    return true;
+}
 
-
-
+bool FinitizedLogarithmicDistribution::seriesCoefficients(double theta, DoubleDouble* b) const {
+    if (!(theta > 0.0 && theta < 1.0))
+        return false;
+    const DoubleDouble q = DoubleDouble(1.0) - DoubleDouble(theta);     // exact
+    const DoubleDouble L = log(q);
+    const DoubleDouble r = DoubleDouble(theta) / q;
+    DoubleDouble rm(1.0);               // r^m
+    DoubleDouble S = L;
+    b[0] = DoubleDouble(1.0);
+    for (int m = 1; m <= m_finitizationOrder; ++m) {
+        rm = rm * r;
+        S = -(rm / DoubleDouble(m)) - S;
+        b[m] = S / L;
+    }
+    return true;
+}
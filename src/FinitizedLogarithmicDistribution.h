@@ -44,6 +44,13 @@ public:
      */
     virtual ~FinitizedLogarithmicDistribution();
 
+    /**
+     * @brief Returns the distribution type (DistributionType::LOGARITHMIC).
+     */
+    int getType() const override;
+
+    std::unique_ptr<Finitization> clone() const override;
+
 private:
     /**
      * @brief Native symbolic distribution form for the Logarithmic distribution.
@@ -62,6 +69,16 @@ private:
      * @return GiNaC symbolic expression of the PGF for the logarithmic distribution.
      */
     ex ntsd_base(symbol x, symbol theta) override;
+
+    /**
+     * @brief Scaled series coefficients computed with a first-order recurrence.
+     *
+     * With \f$ L = \log(1-\theta) \f$, \f$ c_0 = L \f$ and \f$ c_m = -(\theta/(1-\theta))^m / m \f$,
+     * the coefficients are \f$ b_j = S_j / L \f$, where \f$ S_0 = L \f$ and \f$ S_j = c_j - S_{j-1} \f$.
+     * Returns false unless \f$ 0 < \theta < 1 \f$.
+     */
+    bool seriesCoefficients(double theta, double* b) const override;
+    bool seriesCoefficients(double theta, DoubleDouble* b) const override;
 };
 
 #endif /* FINITIZEDLOGARITHMICDISTRIBUTION_H_ */
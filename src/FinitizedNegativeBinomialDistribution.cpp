@@ -5,6 +5,8 @@
  *      Author: Bogdan.Oancea
  */
 #include "FinitizedNegativeBinomialDistribution.h"
+#include "DistributionType.h"
+#include "DoubleDouble.h"
 #include <ginac/ginac.h>
 
 using namespace std;
@@ -15,18 +17,8 @@ FinitizedNegativeBinomialDistribution::FinitizedNegativeBinomialDistribution(int
     m_paramSymb = symbol("q");          // Symbol for the transformed parameter q
     m_x = symbol("x");                  // Symbol for the random variable
 
-    m_dprobs = new double[n + 1];       // Allocate memory for finitized probabilities
-
-    // Compute and cache PDF values for the finitized distribution
-    for (int i = 0; i <= n; ++i) {
-        m_dprobs[i] = fin_pdf(i);
-    }
-
-    // Initialize the alias sampling structure
-    setProbs(m_dprobs);
-
-    // Mark the setup as finished
-    m_finish = true;
+    // Compute finitized PDF values for x = 0 to n and initialize the alias sampling table
+    computeProbs();
 }
 
 FinitizedNegativeBinomialDistribution::~FinitizedNegativeBinomialDistribution() {
@@ -36,3 +28,49 @@ ex FinitizedNegativeBinomialDistribution::ntsd_base(symbol x, symbol theta){
     return pow( 1 /(1-x/(1-theta)), m_k);
 }
 
+int FinitizedNegativeBinomialDistribution::getType() const {
+    return DistributionType::NEGATIVEBINOMIAL;
+}
+
+std::unique_ptr<Finitization> FinitizedNegativeBinomialDistribution::clone() const {
+    return std::unique_ptr<Finitization>(new FinitizedNegativeBinomialDistribution(*this));
+}
+
+int FinitizedNegativeBinomialDistribution::getSizeParameter() const {
+    return m_k;
+}
+
+bool FinitizedNegativeBinomialDistribution::seriesCoefficients(double theta, double* b) const {
+    if (theta == 1.0)
+        return false;
+    const double r = theta / (1.0 - theta);
+    b[0] = 1.0;
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        b[j] = b[j - 1] * (m_k + j - 1) / j * r;
+    return true;
+}
+
+bool FinitizedNegativeBinomialDistribution::seriesCoefficients(double theta, DoubleDouble* b) const {
+    if (theta == 1.0)
+        return false;
+    const DoubleDouble r = DoubleDouble(theta) / (DoubleDouble(1.0) - DoubleDouble(theta));
+    b[0] = DoubleDouble(1.0);
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        b[j] = b[j - 1] * DoubleDouble(m_k + j - 1) / DoubleDouble(j) * r;
+    return true;
+}
+
+bool FinitizedNegativeBinomialDistribution::seriesConstants(double* a) const {
+    a[0] = 1.0;
+    for (int j = 1; j <= m_finitizationOrder; ++j)
+        a[j] = a[j - 1] * (m_k + j - 1) / j;
+    return true;
+}
+
+double FinitizedNegativeBinomialDistribution::seriesArgument(double theta) const {
+    return theta / (1.0 - theta);
+}
+
+double FinitizedNegativeBinomialDistribution::seriesParameter(double u) const {
+    return u / (1.0 + u);
+}
@@ -45,6 +45,18 @@ public:
      */
     virtual ~FinitizedNegativeBinomialDistribution();
 
+    /**
+     * @brief Returns the distribution type (DistributionType::NEGATIVEBINOMIAL).
+     */
+    int getType() const override;
+
+    std::unique_ptr<Finitization> clone() const override;
+
+    /**
+     * @brief Returns the parameter k.
+     */
+    int getSizeParameter() const override;
+
 private:
     int m_k;  ///< Number of failures parameter for the Negative Binomial distribution
 
@@ -63,6 +75,29 @@ private:
      * @return A symbolic GiNaC expression for the PGF of the Negative Binomial distribution.
      */
     ex ntsd_base(symbol x, symbol theta) override;
+
+    /**
+     * @brief Closed-form scaled series coefficients \f$ b_j = \binom{k+j-1}{j} r^j \f$, with \f$ r = q/(1-q) \f$.
+     *
+     * Returns false for q = 1, where the native series is not defined.
+     */
+    bool seriesCoefficients(double theta, double* b) const override;
+    bool seriesCoefficients(double theta, DoubleDouble* b) const override;
+
+    /**
+     * @brief Constant series coefficients \f$ a_j = \binom{k+j-1}{j} \f$, in the argument \f$ r = q/(1-q) \f$.
+     */
+    bool seriesConstants(double* a) const override;
+
+    /**
+     * @brief Returns \f$ r = q/(1-q) \f$.
+     */
+    double seriesArgument(double theta) const override;
+
+    /**
+     * @brief Returns \f$ q = r/(1+r) \f$.
+     */
+    double seriesParameter(double u) const override;
 };
 
 #endif /* FINITIZEDNEGATIVEBINOMIALDISTRIBUTION_H_ */
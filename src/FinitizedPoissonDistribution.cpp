@@ -5,6 +5,8 @@
  *      Author: Bogdan.Oancea
  */
 #include "FinitizedPoissonDistribution.h"
+#include "DistributionType.h"
+#include "DoubleDouble.h"
 #include <ginac/ginac.h>
 
 using namespace std;
@@ -14,18 +16,8 @@ FinitizedPoissonDistribution::FinitizedPoissonDistribution(int n, double theta):
 	m_paramSymb = symbol("theta");       // Symbol used in symbolic expressions for lambda
 	m_x = symbol("x");                   // Symbol representing the discrete outcome variable
 
-	m_dprobs = new double[n + 1];        // Allocate memory for finitized probabilities
-
-	// Compute finitized PDF for all values from 0 to n
-	for (int i = 0; i <= n; ++i) {
-	    m_dprobs[i] = fin_pdf(i);
-	}
-
-	// Initialize internal sampling structure with computed probabilities
-	setProbs(m_dprobs);
-
-	// Mark setup as completed
-	m_finish = true;
+	// Compute finitized PDF values for x = 0 to n and initialize the alias sampling table
+	computeProbs();
 }
 
 FinitizedPoissonDistribution::~FinitizedPoissonDistribution() {
@@ -36,8 +28,31 @@ ex FinitizedPoissonDistribution::ntsd_base(symbol x, symbol theta){
 	return exp(x);
 }
 
+int FinitizedPoissonDistribution::getType() const {
+	return DistributionType::POISSON;
+}
 
+std::unique_ptr<Finitization> FinitizedPoissonDistribution::clone() const {
+	return std::unique_ptr<Finitization>(new FinitizedPoissonDistribution(*this));
+}
 
+bool FinitizedPoissonDistribution::seriesCoefficients(double theta, double* b) const {
+	b[0] = 1.0;
+	for (int j = 1; j <= m_finitizationOrder; ++j)
+		b[j] = b[j - 1] * theta / j;
+	return true;
+}
 
+bool FinitizedPoissonDistribution::seriesCoefficients(double theta, DoubleDouble* b) const {
+	b[0] = DoubleDouble(1.0);
+	for (int j = 1; j <= m_finitizationOrder; ++j)
+		b[j] = b[j - 1] * DoubleDouble(theta) / DoubleDouble(j);
+	return true;
+}
 
-
+bool FinitizedPoissonDistribution::seriesConstants(double* a) const {
+	a[0] = 1.0;
+	for (int j = 1; j <= m_finitizationOrder; ++j)
+		a[j] = a[j - 1] / j;
+	return true;
+}
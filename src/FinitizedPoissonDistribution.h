@@ -42,6 +42,13 @@ public:
      */
     virtual ~FinitizedPoissonDistribution();
 
+    /**
+     * @brief Returns the distribution type (DistributionType::POISSON).
+     */
+    int getType() const override;
+
+    std::unique_ptr<Finitization> clone() const override;
+
 private:
     /**
      * @brief Symbolic form of the Poisson distribution's probability generating function.
@@ -54,6 +61,17 @@ private:
      * @return Symbolic expression representing the native PGF.
      */
     ex ntsd_base(symbol x, symbol theta) override;
+
+    /**
+     * @brief Closed-form scaled series coefficients \f$ b_j = \theta^j / j! \f$.
+     */
+    bool seriesCoefficients(double theta, double* b) const override;
+    bool seriesCoefficients(double theta, DoubleDouble* b) const override;
+
+    /**
+     * @brief Constant series coefficients \f$ a_j = 1 / j! \f$.
+     */
+    bool seriesConstants(double* a) const override;
 };
 
 #endif /* FINITIZEDPOISSONDISTRIBUTION_H_ */
@@ -0,0 +1,24 @@
+#ifndef GOFTEST_H_
+#define GOFTEST_H_
+
+/**
+ * @class GofTest
+ * @brief Constants identifying the goodness of fit statistics.
+ *
+ * The values follow the order of the names accepted by gofFinitized():
+ * "chisq", "g", "ks".
+ */
+class GofTest {
+
+public:
+    // Pearson's chi-square: sum of (O - E)^2 / E
+    static const int CHI_SQUARE = 0;
+
+    // Likelihood ratio (G-test): 2 sum of O log(O / E)
+    static const int G = 1;
+
+    // Kolmogorov: largest absolute difference between the empirical and the model CDF
+    static const int KOLMOGOROV = 2;
+};
+
+#endif /* GOFTEST_H_ */
@@ -0,0 +1,231 @@
+/*
+ * GoodnessOfFit.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "GoodnessOfFit.h"
+#include "GofTest.h"
+#include "ParallelFor.h"
+#include "Xoshiro256.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Stirling correction log(k!) - log(sqrt(2 pi)) - (k + 1/2) log(k + 1) + k + 1 of BTRD
+static double stirlingCorrection(double k) {
+    static const double TABLE[] = { 0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+                                    0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+                                    0.01189670994589177, 0.01041126526197209, 0.009255462182712733,
+                                    0.008330563433362871 };
+    if (k <= 9.0)
+        return TABLE[static_cast<int>(k)];
+    const double k1 = k + 1.0, k2 = k1 * k1;
+    return (1.0 / 12.0 - (1.0 / 360.0 - 1.0 / 1260.0 / k2) / k2) / k1;
+}
+
+// A binomial(n, p) value, p <= 1/2, by inversion when np < 10 and by Hörmann's transformed
+// rejection with decomposition (BTRD) otherwise; O(1) expected uniforms in both cases.
+static double binomialLower(Xoshiro256& g, double n, double p) {
+    const double q = 1.0 - p;
+    if (n * p < 10.0) {
+        const double s = p / q, a = (n + 1.0) * s, r0 = std::pow(q, n);
+        for (;;) {
+            double u = g.nextDouble(), r = r0, x = 0.0;
+            while (u > r && x < n) {
+                u -= r;
+                x += 1.0;
+                r *= a / x - s;
+            }
+            if (u <= r)
+                return x;
+        }
+    }
+
+    const double m = std::floor((n + 1.0) * p);
+    const double r = p / q, nr = (n + 1.0) * r, npq = n * p * q;
+    const double sq = std::sqrt(npq);
+    const double b = 1.15 + 2.53 * sq;
+    const double a = -0.0873 + 0.0248 * b + 0.01 * p;
+    const double c = n * p + 0.5;
+    const double alpha = (2.83 + 5.1 / b) * sq;
+    const double vr = 0.92 - 4.2 / b;
+    const double urvr = 0.86 * vr;
+    for (;;) {
+        double v = g.nextDouble(), u;
+        if (v <= urvr) {
+            u = v / vr - 0.43;
+            return std::floor((2.0 * a / (0.5 - std::fabs(u)) + b) * u + c);
+        }
+        if (v >= vr) {
+            u = g.nextDouble() - 0.5;
+        } else {
+            u = v / vr - 0.93;
+            u = (u < 0.0 ? -0.5 : 0.5) - u;
+            v = g.nextDouble() * vr;
+        }
+        const double us = 0.5 - std::fabs(u);
+        const double k = std::floor((2.0 * a / us + b) * u + c);
+        if (k < 0.0 || k > n)
+            continue;
+        v = v * alpha / (a / (us * us) + b);
+        const double km = std::fabs(k - m);
+        if (km <= 15.0) {
+            // Ratio of the probabilities of k and m by the recurrence
+            double f = 1.0;
+            if (m < k) {
+                for (double i = m + 1.0; i <= k; i += 1.0)
+                    f *= nr / i - r;
+            } else {
+                for (double i = k + 1.0; i <= m; i += 1.0)
+                    v *= nr / i - r;
+            }
+            if (v <= f)
+                return k;
+            continue;
+        }
+        // Squeeze on the logarithm, then the exact ratio from Stirling's formula
+        v = std::log(v);
+        const double rho = (km / npq) * (((km / 3.0 + 0.625) * km + 1.0 / 6.0) / npq + 0.5);
+        const double t = -km * km / (2.0 * npq);
+        if (v < t - rho)
+            return k;
+        if (v > t + rho)
+            continue;
+        const double nm = n - m + 1.0, nk = n - k + 1.0;
+        const double h = (m + 0.5) * std::log((m + 1.0) / (r * nm)) + stirlingCorrection(m) +
+                         stirlingCorrection(n - m);
+        if (v <= h + (n + 1.0) * std::log(nm / nk) + (k + 0.5) * std::log(nk * r / (k + 1.0)) -
+                 stirlingCorrection(k) - stirlingCorrection(n - k))
+            return k;
+    }
+}
+
+static double binomial(Xoshiro256& g, double n, double p) {
+    if (n <= 0.0 || p <= 0.0)
+        return 0.0;
+    if (p >= 1.0)
+        return n;
+    return (p <= 0.5) ? binomialLower(g, n, p) : n - binomialLower(g, n, 1.0 - p);
+}
+
+GoodnessOfFit::GoodnessOfFit(int test, const double* probs, int n): m_test(test), m_order(n),
+    m_probs(probs, probs + n + 1), m_cdf(n + 1), m_tail(n + 1) {
+    double sum = 0.0;
+    for (int x = 0; x <= n; ++x) {
+        sum += m_probs[x];
+        m_cdf[x] = sum;
+    }
+    // Summed from the right, so that the small tails keep their relative accuracy
+    sum = 0.0;
+    for (int x = n; x >= 0; --x) {
+        sum += m_probs[x];
+        m_tail[x] = sum;
+    }
+}
+
+double GoodnessOfFit::statistic(const double* counts) const {
+    double total = 0.0;
+    for (int x = 0; x <= m_order; ++x)
+        total += counts[x];
+
+    double result = 0.0;
+    switch(m_test) {
+    case GofTest::CHI_SQUARE:
+        for (int x = 0; x <= m_order; ++x) {
+            const double expected = total * m_probs[x];
+            if (expected > 0.0)
+                result += (counts[x] - expected) * (counts[x] - expected) / expected;
+            else if (counts[x] > 0.0)
+                return std::numeric_limits<double>::infinity();
+        }
+        break;
+    case GofTest::G:
+        for (int x = 0; x <= m_order; ++x) {
+            if (counts[x] <= 0.0)
+                continue;
+            const double expected = total * m_probs[x];
+            if (!(expected > 0.0))
+                return std::numeric_limits<double>::infinity();
+            result += counts[x] * std::log(counts[x] / expected);
+        }
+        result *= 2.0;
+        break;
+    case GofTest::KOLMOGOROV: {
+        double cumulative = 0.0;
+        for (int x = 0; x <= m_order; ++x) {
+            cumulative += counts[x];
+            result = std::max(result, std::fabs(cumulative / total - m_cdf[x]));
+        }
+        break;
+    }
+    default:
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return result;
+}
+
+int GoodnessOfFit::exceedances(const double* cutoff, const int* alias, uint64_t size, double observed,
+                               int replicates, uint64_t seed, int nthreads) const {
+    const double threshold = observed * (1.0 - 64.0 * std::numeric_limits<double>::epsilon());
+    const uint32_t last = static_cast<uint32_t>(m_order);
+    const bool multinomial = size > MULTINOMIAL_MIN_DRAWS * static_cast<uint64_t>(m_order + 1);
+    std::vector<int> hits(replicates, 0);
+    parallelFor(replicates, nthreads, [&](int begin, int end) {
+        Xoshiro256 stream(seed);
+        for (int r = 0; r < begin; ++r)
+            stream.jump();
+        std::vector<double> counts(m_order + 1);
+        for (int r = begin; r < end; ++r) {
+            Xoshiro256 g = stream;
+            std::fill(counts.begin(), counts.end(), 0.0);
+            if (multinomial) {
+                drawCounts(g, static_cast<double>(size), counts.data());
+            } else {
+                for (uint64_t i = 0; i < size; ++i) {
+                    // Same operations as the scalar alias kernel
+                    const double uK = g.nextDouble() * static_cast<double>(last + 1);
+                    uint32_t j = (uint32_t)uK;
+                    if (j > last)
+                        j = last;
+                    const double f = uK - (double)j;
+                    counts[(f < cutoff[j]) ? (int)j : alias[j]] += 1.0;
+                }
+            }
+            hits[r] = statistic(counts.data()) >= threshold ? 1 : 0;
+            stream.jump();
+        }
+    });
+
+    int result = 0;
+    for (int r = 0; r < replicates; ++r)
+        result += hits[r];
+    return result;
+}
+
+void GoodnessOfFit::drawCounts(Xoshiro256& g, double size, double* counts) const {
+    // counts[x] given the counts of 0, ..., x - 1 is binomial(rest, p_x / (p_x + ... + p_n))
+    double rest = size;
+    for (int x = 0; x < m_order && rest > 0.0; ++x) {
+        const double p = (m_tail[x] > 0.0) ? std::min(1.0, m_probs[x] / m_tail[x]) : 1.0;
+        counts[x] = binomial(g, rest, p);
+        rest -= counts[x];
+    }
+    counts[m_order] += rest;
+}
+
+double GoodnessOfFit::kolmogorovPValue(double d, double size) {
+    const double t = std::sqrt(size) * d;
+    // P(K > t) = 2 sum_{k >= 1} (-1)^(k - 1) exp(-2 k^2 t^2), 1 to double precision below 0.2
+    if (t < 0.2)
+        return 1.0;
+    double sum = 0.0;
+    for (int k = 1; k <= 100; ++k) {
+        const double term = std::exp(-2.0 * k * k * t * t);
+        sum += (k % 2 == 1) ? term : -term;
+        if (term < 1e-17)
+            break;
+    }
+    return std::min(1.0, std::max(0.0, 2.0 * sum));
+}
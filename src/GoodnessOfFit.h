@@ -0,0 +1,89 @@
+/*
+ * GoodnessOfFit.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef GOODNESSOFFIT_H_
+#define GOODNESSOFFIT_H_
+
+#include <cstdint>
+#include <vector>
+#include "Xoshiro256.h"
+
+/**
+ * @class GoodnessOfFit
+ * @brief Goodness of fit statistics of a histogram for a finitized distribution.
+ *
+ * The statistics (see GofTest) depend on the sample only through the counts
+ * of the values 0, ..., n, so computing one costs O(n) whatever the sample
+ * size. The Monte Carlo p-value draws the counts of samples of the same size
+ * from the distribution: value by value with its alias tables for small
+ * samples, and otherwise from the multinomial distribution as a sequence of
+ * conditional binomial counts, in O(n) per replicate whatever the sample size.
+ * Each replicate has its own xoshiro256++ stream (the seed advanced by one
+ * jump per replicate), the replicates being distributed over worker threads;
+ * the result does not depend on the number of threads.
+ */
+class GoodnessOfFit {
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param test The statistic (see GofTest).
+     * @param probs The probabilities of the values 0, ..., n.
+     * @param n The finitization order.
+     */
+    GoodnessOfFit(int test, const double* probs, int n);
+
+    /**
+     * @brief Computes the statistic of a histogram.
+     *
+     * @param counts The counts of the values 0, ..., n.
+     * @return The statistic; +Inf if a value of probability 0 has a positive count (chi-square and G).
+     */
+    double statistic(const double* counts) const;
+
+    /**
+     * @brief Counts the replicates whose statistic is at least \p observed.
+     *
+     * @param cutoff The cutoffs of the alias tables of the distribution (see Finitization::aliasTables()).
+     * @param alias The aliases of the alias tables.
+     * @param size The sample size of a replicate; above MULTINOMIAL_MIN_DRAWS draws per support
+     * point, the counts are drawn from the multinomial distribution instead of the alias tables.
+     * @param observed The statistic of the sample.
+     * @param replicates The number of replicates.
+     * @param seed The seed of the first replicate.
+     * @param nthreads The number of threads (<= 0 uses all the hardware threads).
+     * @return The number of replicates whose statistic is not smaller than \p observed
+     * (up to a relative tolerance of 64 machine epsilons, as chisq.test()).
+     */
+    int exceedances(const double* cutoff, const int* alias, uint64_t size, double observed, int replicates,
+                    uint64_t seed, int nthreads) const;
+
+    /**
+     * @brief Asymptotic p-value of the Kolmogorov statistic \p d of a sample of size \p size.
+     *
+     * The limiting distribution of sqrt(size) d is that of a continuous distribution,
+     * so the p-value is conservative for a discrete one.
+     */
+    static double kolmogorovPValue(double d, double size);
+
+    static const int MULTINOMIAL_MIN_DRAWS = 16;   ///< Draws per support point from which the counts are multinomial
+
+private:
+    /**
+     * @brief Adds to \p counts the counts of a sample of \p size values, drawn as conditional binomials.
+     */
+    void drawCounts(Xoshiro256& g, double size, double* counts) const;
+
+    int m_test;
+    int m_order;
+    std::vector<double> m_probs;    ///< Probabilities of 0, ..., n
+    std::vector<double> m_cdf;      ///< Cumulative probabilities of 0, ..., n
+    std::vector<double> m_tail;     ///< Upper tail probabilities of 0, ..., n
+};
+
+#endif /* GOODNESSOFFIT_H_ */
@@ -0,0 +1,207 @@
+/*
+ * Histogram.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "Histogram.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace Rcpp;
+
+// Values counted between two flushes of the 32-bit sub-histograms
+static const std::size_t BLOCK = 1 << 24;
+
+// Fewest values given to a thread
+static const std::size_t MIN_PART = 1 << 16;
+
+// The bin of a value: itself in 0, ..., n, n + 1 otherwise
+static inline int bin(int v, int n) {
+    return static_cast<unsigned>(v) <= static_cast<unsigned>(n) ? v : n + 1;
+}
+
+static inline int bin(double v, int n) {
+    // NaN fails both comparisons
+    const bool inside = v >= 0.0 && v <= n && v == static_cast<double>(static_cast<int>(v));
+    return inside ? static_cast<int>(v) : n + 1;
+}
+
+// Counts values[0, size) into counts[0, n + 1]
+template<typename T>
+static void countPart(const T* values, std::size_t size, int n, uint64_t* counts) {
+    const int bins = n + 2;
+    std::vector<uint32_t> sub(4 * bins);
+    uint32_t* c0 = sub.data();
+    uint32_t* c1 = c0 + bins;
+    uint32_t* c2 = c1 + bins;
+    uint32_t* c3 = c2 + bins;
+    for (std::size_t start = 0; start < size; start += BLOCK) {
+        const std::size_t end = std::min(size, start + BLOCK);
+        std::size_t i = start;
+        for (; i + 4 <= end; i += 4) {
+            ++c0[bin(values[i], n)];
+            ++c1[bin(values[i + 1], n)];
+            ++c2[bin(values[i + 2], n)];
+            ++c3[bin(values[i + 3], n)];
+        }
+        for (; i < end; ++i)
+            ++c0[bin(values[i], n)];
+        for (int b = 0; b < bins; ++b) {
+            counts[b] += static_cast<uint64_t>(c0[b]) + c1[b] + c2[b] + c3[b];
+            c0[b] = c1[b] = c2[b] = c3[b] = 0;
+        }
+    }
+}
+
+Histogram::Histogram(int n): m_order(n), m_counts(n + 2, 0) {
+    if (n < 0)
+        stop("The order of a histogram must be nonnegative.");
+}
+
+int Histogram::order() const {
+    return m_order;
+}
+
+uint64_t Histogram::count(int x) const {
+    return m_counts[x];
+}
+
+uint64_t Histogram::outside() const {
+    return m_counts[m_order + 1];
+}
+
+uint64_t Histogram::total() const {
+    uint64_t total = 0;
+    for (size_t b = 0; b < m_counts.size(); ++b)
+        total += m_counts[b];
+    return total;
+}
+
+void Histogram::add(const int* values, std::size_t size, int nthreads) {
+    accumulate(values, size, nthreads);
+}
+
+void Histogram::add(const double* values, std::size_t size, int nthreads) {
+    accumulate(values, size, nthreads);
+}
+
+template<typename T>
+void Histogram::accumulate(const T* values, std::size_t size, int nthreads) {
+    const std::size_t limit = std::max<std::size_t>(1, size / MIN_PART);
+    const int parts = resolveThreads(nthreads, static_cast<int>(std::min<std::size_t>(limit, 1024)));
+    const int bins = m_order + 2;
+    if (parts == 1) {
+        countPart(values, size, m_order, m_counts.data());
+        return;
+    }
+
+    // One histogram per part, merged at the end
+    std::vector<uint64_t> counts(static_cast<std::size_t>(parts) * bins, 0);
+    const int n = m_order;
+    parallelFor(parts, parts, [&](int begin, int end) {
+        for (int p = begin; p < end; ++p) {
+            const std::size_t first = size / parts * p + std::min<std::size_t>(p, size % parts);
+            const std::size_t length = size / parts + (static_cast<std::size_t>(p) < size % parts ? 1 : 0);
+            countPart(values + first, length, n, counts.data() + static_cast<std::size_t>(p) * bins);
+        }
+    });
+    for (int p = 0; p < parts; ++p)
+        for (int b = 0; b < bins; ++b)
+            m_counts[b] += counts[static_cast<std::size_t>(p) * bins + b];
+}
+
+void Histogram::addBinaryFile(const std::string& path, std::size_t chunk, int nthreads) {
+    MappedFile in(path);
+    if (in.size() % sizeof(int) != 0)
+        stop("The size of %s is not a multiple of %d bytes.", path, (int)sizeof(int));
+    const uint64_t total = in.size() / sizeof(int);
+    for (uint64_t done = 0; done < total; ) {
+        checkUserInterrupt();
+        const std::size_t count = static_cast<std::size_t>(std::min<uint64_t>(chunk, total - done));
+        const int* values = reinterpret_cast<const int*>(in.map(done * sizeof(int), count * sizeof(int)));
+        add(values, count, nthreads);
+        done += count;
+    }
+    in.unmap();
+}
+
+static inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',';
+}
+
+// Parses the integer tokens of text[0, size), which ends at a separator, into values
+static void parseIntegers(const char* text, std::size_t size, std::vector<int>& values) {
+    values.clear();
+    std::size_t i = 0;
+    while (i < size) {
+        if (isSeparator(text[i])) {
+            ++i;
+            continue;
+        }
+        const std::size_t start = i;
+        while (i < size && !isSeparator(text[i]))
+            ++i;
+        // A token that is not a nonnegative integer (below 2^31) gets NA_INTEGER, which is outside 0, ..., n
+        std::size_t j = start;
+        if (text[j] == '+')
+            ++j;
+        int64_t value = 0;
+        bool valid = j < i;
+        for (; j < i && valid; ++j) {
+            if (text[j] < '0' || text[j] > '9')
+                valid = false;
+            else {
+                value = 10 * value + (text[j] - '0');
+                if (value > std::numeric_limits<int>::max())
+                    valid = false;
+            }
+        }
+        values.push_back(valid ? static_cast<int>(value) : NA_INTEGER);
+    }
+}
+
+void Histogram::addTextFile(const std::string& path, std::size_t chunk, int nthreads) {
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in)
+        stop("Cannot open the file %s.", path);
+
+    std::vector<char> buffer(chunk);
+    std::vector<int> values;
+    std::size_t kept = 0;       // bytes of an incomplete token carried over from the previous read
+    try {
+        for (;;) {
+            checkUserInterrupt();
+            if (kept == buffer.size())
+                buffer.resize(2 * buffer.size());      // a token longer than the buffer
+            const std::size_t read = std::fread(buffer.data() + kept, 1, buffer.size() - kept, in);
+            const std::size_t size = kept + read;
+            if (read == 0) {
+                if (std::ferror(in))
+                    stop("Cannot read the file %s.", path);
+                parseIntegers(buffer.data(), size, values);
+                add(values.data(), values.size(), nthreads);
+                break;
+            }
+            // Parse up to the last separator and keep the rest for the next read
+            std::size_t last = size;
+            while (last > 0 && !isSeparator(buffer[last - 1]))
+                --last;
+            parseIntegers(buffer.data(), last, values);
+            add(values.data(), values.size(), nthreads);
+            kept = size - last;
+            std::memmove(buffer.data(), buffer.data() + last, kept);
+        }
+    }
+    catch (...) {
+        std::fclose(in);
+        throw;
+    }
+    std::fclose(in);
+}
@@ -0,0 +1,100 @@
+/*
+ * Histogram.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class Histogram
+ * @brief The counts of the values 0, ..., n in a sample of any size.
+ *
+ * The support of a finitized distribution of order n is {0, ..., n}, so these
+ * n + 1 counts are a sufficient statistic: the likelihood, the goodness of fit
+ * tests and the estimates of a sample depend on it only through them. A
+ * histogram is filled by add() from blocks of values, a block being split into
+ * contiguous parts counted by worker threads. Each part is counted into four
+ * interleaved sub-histograms (consecutive values go to different ones, so that
+ * repeated values do not wait for each other's increments) and the bin of a
+ * value is selected without branches, values outside {0, ..., n}, NA included,
+ * going to an extra bin. Files of values are read one window (or one buffer)
+ * at a time, so the memory used does not depend on the size of the sample.
+ */
+class Histogram {
+
+public:
+    /**
+     * @brief Constructor. Creates an empty histogram of the values 0, ..., \p n.
+     */
+    explicit Histogram(int n);
+
+    /**
+     * @brief Returns the order n.
+     */
+    int order() const;
+
+    /**
+     * @brief Returns the count of the value \p x, 0 <= x <= n.
+     */
+    uint64_t count(int x) const;
+
+    /**
+     * @brief Returns the number of values counted outside 0, ..., n (NA included).
+     */
+    uint64_t outside() const;
+
+    /**
+     * @brief Returns the number of values counted, inside or outside 0, ..., n.
+     */
+    uint64_t total() const;
+
+    /**
+     * @brief Counts a block of integer values (NA_INTEGER is outside 0, ..., n).
+     *
+     * @param values The values.
+     * @param size The number of values.
+     * @param nthreads The number of threads (<= 0 uses all the hardware threads).
+     */
+    void add(const int* values, std::size_t size, int nthreads);
+
+    /**
+     * @brief Counts a block of real values; a value that is not an integer is outside 0, ..., n.
+     */
+    void add(const double* values, std::size_t size, int nthreads);
+
+    /**
+     * @brief Counts the values of a binary file of 32-bit integers in the native byte order.
+     *
+     * The file is memory-mapped one window of \p chunk values at a time.
+     *
+     * @throws Rcpp::exception if the file cannot be read or its size is not a multiple of 4 bytes.
+     */
+    void addBinaryFile(const std::string& path, std::size_t chunk, int nthreads);
+
+    /**
+     * @brief Counts the values of a text file, read \p chunk bytes at a time.
+     *
+     * The values are separated by blanks, commas or line ends; a token that is not
+     * an integer (e.g. NA or 1.5) is counted outside 0, ..., n.
+     *
+     * @throws Rcpp::exception if the file cannot be read.
+     */
+    void addTextFile(const std::string& path, std::size_t chunk, int nthreads);
+
+private:
+    template<typename T>
+    void accumulate(const T* values, std::size_t size, int nthreads);
+
+    int m_order;
+    std::vector<uint64_t> m_counts;     ///< Counts of 0, ..., n, and of the values outside in bin n + 1
+};
+
+#endif /* HISTOGRAM_H_ */
@@ -0,0 +1,63 @@
+/*
+ * Instrumentation.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "Instrumentation.h"
+
+static const char* PHASE_NAMES[] = { "series", "derivatives", "evaluation", "numeric", "template",
+                                     "tables", "sampling" };
+static const char* COUNTER_NAMES[] = { "cache hits", "cache misses", "bytes allocated" };
+
+bool Instrumentation::s_enabled = false;
+double Instrumentation::s_calls[Instrumentation::PHASES] = { 0 };
+double Instrumentation::s_seconds[Instrumentation::PHASES] = { 0 };
+double Instrumentation::s_counters[Instrumentation::COUNTERS] = { 0 };
+
+bool Instrumentation::setEnabled(bool enabled) {
+    const bool previous = s_enabled;
+#if FINITIZATION_INSTRUMENT
+    s_enabled = enabled;
+#else
+    (void)enabled;
+#endif
+    return previous;
+}
+
+void Instrumentation::record(int phase, double seconds) {
+    s_calls[phase] += 1.0;
+    s_seconds[phase] += seconds;
+}
+
+void Instrumentation::add(int counter, double amount) {
+    s_counters[counter] += amount;
+}
+
+void Instrumentation::reset() {
+    for (int i = 0; i < PHASES; ++i)
+        s_calls[i] = s_seconds[i] = 0.0;
+    for (int i = 0; i < COUNTERS; ++i)
+        s_counters[i] = 0.0;
+}
+
+const char* Instrumentation::phaseName(int phase) {
+    return PHASE_NAMES[phase];
+}
+
+const char* Instrumentation::counterName(int counter) {
+    return COUNTER_NAMES[counter];
+}
+
+double Instrumentation::calls(int phase) {
+    return s_calls[phase];
+}
+
+double Instrumentation::seconds(int phase) {
+    return s_seconds[phase];
+}
+
+double Instrumentation::counter(int counter) {
+    return s_counters[counter];
+}
@@ -0,0 +1,130 @@
+/*
+ * Instrumentation.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef INSTRUMENTATION_H_
+#define INSTRUMENTATION_H_
+
+#include <chrono>
+#include <cstddef>
+
+// Compile with -DFINITIZATION_INSTRUMENT=0 to remove all the instrumentation code
+#ifndef FINITIZATION_INSTRUMENT
+#define FINITIZATION_INSTRUMENT 1
+#endif
+
+/**
+ * @class Instrumentation
+ * @brief Process-wide timers and counters of the computational phases.
+ *
+ * Each phase accumulates the number of times it ran and the elapsed time;
+ * the counters accumulate events such as cache hits or allocated bytes.
+ * Recording is off until enabled at run time, and then only costs a test of
+ * a flag; if the package is compiled with FINITIZATION_INSTRUMENT set to 0,
+ * the FINITIZATION_TIMER and FINITIZATION_COUNT macros expand to nothing.
+ * The timers and counters are plain statics, not thread-safe: they must only
+ * be used from the R main thread, never from the body of a parallelFor() or
+ * a ValueStream worker. Parallel loops are timed as a whole by their caller.
+ */
+class Instrumentation {
+
+public:
+    // Phases
+    static const int SERIES = 0;        ///< Series expansion of the generating function
+    static const int DERIVATIVES = 1;   ///< Derivatives and substitutions of the symbolic PMF
+    static const int EVALUATION = 2;    ///< evalf/subs of the symbolic PMF in fin_pdf()
+    static const int NUMERIC = 3;       ///< Numeric PMF (series coefficients or template)
+    static const int TEMPLATE = 4;      ///< Derivation of the PMF templates
+    static const int TABLES = 5;        ///< Construction of the sampling tables in setProbs()
+    static const int SAMPLING = 6;      ///< Generation of random values
+    static const int PHASES = 7;
+
+    // Counters
+    static const int CACHE_HITS = 0;    ///< Distributions found in the cache
+    static const int CACHE_MISSES = 1;  ///< Distributions built or extended
+    static const int BYTES = 2;         ///< Bytes allocated for probabilities and sampling tables
+    static const int COUNTERS = 3;
+
+    /**
+     * @brief Tells if recording is enabled.
+     */
+    static bool enabled() {
+        return s_enabled;
+    }
+
+    /**
+     * @brief Enables or disables recording.
+     *
+     * @return The previous state.
+     */
+    static bool setEnabled(bool enabled);
+
+    /**
+     * @brief Adds one run of \p phase lasting \p seconds.
+     */
+    static void record(int phase, double seconds);
+
+    /**
+     * @brief Adds \p amount to \p counter.
+     */
+    static void add(int counter, double amount);
+
+    /**
+     * @brief Sets all the timers and counters to 0.
+     */
+    static void reset();
+
+    static const char* phaseName(int phase);       ///< Name of a phase
+    static const char* counterName(int counter);   ///< Name of a counter
+    static double calls(int phase);                ///< Number of runs of a phase
+    static double seconds(int phase);              ///< Total time spent in a phase
+    static double counter(int counter);            ///< Value of a counter
+
+private:
+    static bool s_enabled;
+    static double s_calls[PHASES];
+    static double s_seconds[PHASES];
+    static double s_counters[COUNTERS];
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the time between its construction and its destruction as one run of a phase.
+ */
+class ScopedTimer {
+
+public:
+    explicit ScopedTimer(int phase): m_phase(phase), m_active(Instrumentation::enabled()) {
+        if (m_active)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (m_active) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+            Instrumentation::record(m_phase, elapsed.count());
+        }
+    }
+
+private:
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+
+    int m_phase;
+    bool m_active;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#if FINITIZATION_INSTRUMENT
+#define FINITIZATION_TIMER(phase) ScopedTimer finitizationScopedTimer(phase)
+#define FINITIZATION_COUNT(counter, amount) \
+    do { if (Instrumentation::enabled()) Instrumentation::add(counter, amount); } while (0)
+#else
+#define FINITIZATION_TIMER(phase) ((void)0)
+#define FINITIZATION_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif /* INSTRUMENTATION_H_ */
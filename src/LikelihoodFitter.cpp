@@ -0,0 +1,114 @@
+/*
+ * LikelihoodFitter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "LikelihoodFitter.h"
+#include "DistributionType.h"
+#include "EvaluationPrecision.h"
+#include <cmath>
+#include <limits>
+
+using namespace Rcpp;
+
+// Relative tolerance on the parameter
+static const double TOLERANCE = 1e-13;
+
+LikelihoodFitter::LikelihoodFitter(Finitization& f): m_order(f.getOrder()),
+    m_extended(Finitization::getPrecision() == EvaluationPrecision::DOUBLE_DOUBLE),
+    m_pmf(m_order + 1), m_first(m_order + 1), m_second(m_order + 1) {
+    const symbol& theta = f.getParameterSymbol();
+    const std::vector<ex> pmfs = f.symbolicPmfs();
+    for (int x = 0; x <= m_order; ++x) {
+        const ex first = pmfs[x].diff(theta);
+        if (!m_pmf[x].compile(pmfs[x], theta) || !m_first[x].compile(first, theta) ||
+            !m_second[x].compile(first.diff(theta), theta))
+            stop("The PMF at %d cannot be compiled.", x);
+    }
+}
+
+int LikelihoodFitter::order() const {
+    return m_order;
+}
+
+void LikelihoodFitter::evaluate(const double* counts, double theta, double& loglik, double& score,
+                                double& hessian) const {
+    loglik = score = hessian = 0.0;
+    bool impossible = false;
+    for (int x = 0; x <= m_order; ++x) {
+        const double c = counts[x];
+        if (c == 0.0)
+            continue;
+        const double f = m_pmf[x].evaluate(theta, m_extended);
+        const double r = m_first[x].evaluate(theta, m_extended) / f;
+        if (!(f > 0.0))
+            impossible = true;
+        else
+            loglik += c * std::log(f);
+        score += c * r;
+        hessian += c * (m_second[x].evaluate(theta, m_extended) / f - r * r);
+    }
+    if (impossible)
+        loglik = -std::numeric_limits<double>::infinity();
+}
+
+double LikelihoodFitter::maximize(const double* counts, double lower, double upper, double start,
+                                  int& iterations) const {
+    // The score is positive left of the maximum and negative right of it: [a, b] keeps
+    // bracketing the maximum, and a Newton step that leaves it is replaced by a bisection.
+    double a = lower, b = upper;
+    double theta = (start >= a && start <= b) ? start : 0.5 * (a + b);
+    iterations = 0;
+    while (iterations < MAX_ITERATIONS) {
+        ++iterations;
+        double loglik, score, hessian;
+        evaluate(counts, theta, loglik, score, hessian);
+        if (std::isnan(score)) {
+            theta = 0.5 * (theta + 0.5 * (a + b));
+            continue;
+        }
+        if (score > 0.0)
+            a = theta;
+        else if (score < 0.0)
+            b = theta;
+        else
+            break;
+
+        double next = (hessian < 0.0) ? theta - score / hessian : std::numeric_limits<double>::quiet_NaN();
+        if (!(next > a && next < b))
+            next = 0.5 * (a + b);
+        const double tol = TOLERANCE * (1.0 + std::fabs(theta));
+        const bool converged = std::fabs(next - theta) <= tol || b - a <= tol;
+        theta = next;
+        if (converged)
+            break;
+    }
+    return theta;
+}
+
+double LikelihoodFitter::momentEstimate(int dtype, int size, double mean) {
+    switch(dtype) {
+    case DistributionType::POISSON:
+        return mean;
+    case DistributionType::BINOMIAL:
+        return size > 0 ? mean / size : std::numeric_limits<double>::quiet_NaN();
+    case DistributionType::NEGATIVEBINOMIAL:
+        return size + mean > 0 ? mean / (size + mean) : std::numeric_limits<double>::quiet_NaN();
+    case DistributionType::LOGARITHMIC: {
+        // The mean increases from 0 to infinity on (0, 1)
+        double lo = 0.0, hi = 1.0;
+        while (hi - lo > TOLERANCE) {
+            const double t = 0.5 * (lo + hi);
+            if (-t / ((1.0 - t) * std::log1p(-t)) - 1.0 < mean)
+                lo = t;
+            else
+                hi = t;
+        }
+        return 0.5 * (lo + hi);
+    }
+    default:
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
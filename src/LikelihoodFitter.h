@@ -0,0 +1,97 @@
+/*
+ * LikelihoodFitter.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef LIKELIHOODFITTER_H_
+#define LIKELIHOODFITTER_H_
+
+#include <vector>
+#include "Finitization.h"
+#include "PmfProgram.h"
+
+/**
+ * @class LikelihoodFitter
+ * @brief Estimates the parameter of a finitized distribution from a histogram of counts.
+ *
+ * The symbolic PMF of each value x = 0, ..., n and its first two derivatives with
+ * respect to the parameter are compiled once into PmfProgram objects, so the
+ * log-likelihood
+ * \f[
+ *     \ell(\theta) = \sum_{x=0}^{n} c_x \log f(x; \theta),
+ * \f]
+ * the score and the Hessian of a histogram \f$ c_0, \ldots, c_n \f$ are evaluated
+ * analytically, in one pass over the support and without GiNaC. The maximum
+ * likelihood estimate is found by Newton's method safeguarded by bisection in an
+ * interval, normally the maximum feasible parameter space (MFPS), so the
+ * estimate never leaves it.
+ */
+class LikelihoodFitter {
+
+public:
+    static const int MAX_ITERATIONS = 100;     ///< Maximum number of Newton or bisection steps
+
+    /**
+     * @brief Compiles the PMF of \p f and its derivatives.
+     *
+     * Only the family, the order and the size parameter of \p f are used.
+     *
+     * @throws Rcpp::exception if a PMF cannot be compiled.
+     */
+    explicit LikelihoodFitter(Finitization& f);
+
+    /**
+     * @brief Returns the finitization order n.
+     */
+    int order() const;
+
+    /**
+     * @brief Evaluates the log-likelihood of a histogram and its derivatives.
+     *
+     * @param counts The counts of the values 0, ..., n.
+     * @param theta The value of the parameter.
+     * @param loglik Output log-likelihood (-Inf if a value with a positive count has probability 0).
+     * @param score Output first derivative of the log-likelihood.
+     * @param hessian Output second derivative of the log-likelihood.
+     */
+    void evaluate(const double* counts, double theta, double& loglik, double& score, double& hessian) const;
+
+    /**
+     * @brief Maximizes the log-likelihood of a histogram in [lower, upper].
+     *
+     * @param counts The counts of the values 0, ..., n.
+     * @param lower The lower limit of the parameter.
+     * @param upper The upper limit of the parameter.
+     * @param start The starting value; the middle of the interval is used if it lies outside.
+     * @param iterations Output number of steps.
+     * @return The estimate of the parameter.
+     */
+    double maximize(const double* counts, double lower, double upper, double start, int& iterations) const;
+
+    /**
+     * @brief Method of moments estimate of the parameter.
+     *
+     * A finitized distribution of order n >= 1 with its parameter in the MFPS has
+     * the mean of its parent distribution, so the estimate solves
+     * mean(theta) = \p mean: theta = mean (Poisson), p = mean / N (Binomial),
+     * q = mean / (k + mean) (Negative Binomial), and a bisection for the
+     * Logarithmic distribution, whose mean is -theta / ((1 - theta) log(1 - theta)) - 1.
+     *
+     * @param dtype The distribution type (see DistributionType).
+     * @param size The size parameter (N or k), ignored for the other distributions.
+     * @param mean The sample mean.
+     * @return The estimate, NaN if the type is unsupported.
+     */
+    static double momentEstimate(int dtype, int size, double mean);
+
+private:
+    int m_order;
+    bool m_extended;                        ///< Evaluate in double-double precision
+    std::vector<PmfProgram> m_pmf;          ///< f(x; theta)
+    std::vector<PmfProgram> m_first;        ///< First derivatives with respect to theta
+    std::vector<PmfProgram> m_second;       ///< Second derivatives with respect to theta
+};
+
+#endif /* LIKELIHOODFITTER_H_ */
@@ -0,0 +1,140 @@
+/*
+ * LruCache.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef LRUCACHE_H_
+#define LRUCACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @class LruCache
+ * @brief A bounded key/value store with least-recently-used eviction.
+ *
+ * Entries are kept in a doubly linked list ordered from the most to the least
+ * recently used one, and an unordered map gives O(1) access to the list nodes.
+ * When an insertion exceeds the capacity, the least recently used entry is dropped.
+ * The cache also counts the lookups that were answered (hits) and the ones that
+ * were not (misses).
+ *
+ * @tparam Key   The key type.
+ * @tparam Value The stored value type (typically a smart pointer).
+ * @tparam Hash  The hash functor for \p Key.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key> >
+class LruCache {
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param capacity Maximum number of entries kept in the cache.
+     */
+    explicit LruCache(std::size_t capacity): m_capacity(capacity), m_hits(0), m_misses(0) {}
+
+    /**
+     * @brief Looks up a key and marks its entry as the most recently used one.
+     *
+     * @param key The key to search for.
+     * @param value Receives the stored value when the key is found.
+     * @return true if the key was found, false otherwise.
+     */
+    bool find(const Key& key, Value& value) {
+        typename Index::iterator it = m_index.find(key);
+        if (it == m_index.end()) {
+            ++m_misses;
+            return false;
+        }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        value = it->second->second;
+        ++m_hits;
+        return true;
+    }
+
+    /**
+     * @brief Looks up a value without marking it as recently used.
+     *
+     * The hit/miss counters are not changed.
+     *
+     * @param key The key to search for.
+     * @param value Receives the stored value when the key is found.
+     * @return true if the key was found, false otherwise.
+     */
+    bool peek(const Key& key, Value& value) const {
+        typename Index::const_iterator it = m_index.find(key);
+        if (it == m_index.end())
+            return false;
+        value = it->second->second;
+        return true;
+    }
+
+    /**
+     * @brief Inserts (or replaces) an entry and evicts the least recently used ones if needed.
+     *
+     * @param key The key of the new entry.
+     * @param value The value of the new entry.
+     */
+    void insert(const Key& key, const Value& value) {
+        if (m_capacity == 0)
+            return;
+        typename Index::iterator it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->second = value;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+        m_entries.push_front(std::make_pair(key, value));
+        m_index[key] = m_entries.begin();
+        evict();
+    }
+
+    /**
+     * @brief Removes all entries and resets the hit/miss counters.
+     */
+    void clear() {
+        m_index.clear();
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    /**
+     * @brief Changes the capacity, evicting entries if the cache is now too large.
+     *
+     * @param capacity The new maximum number of entries.
+     */
+    void setCapacity(std::size_t capacity) {
+        m_capacity = capacity;
+        evict();
+    }
+
+    std::size_t size() const { return m_entries.size(); }      ///< Number of stored entries
+    std::size_t capacity() const { return m_capacity; }        ///< Maximum number of entries
+    std::size_t hits() const { return m_hits; }                ///< Number of successful lookups
+    std::size_t misses() const { return m_misses; }            ///< Number of failed lookups
+
+private:
+    typedef std::list<std::pair<Key, Value> > Entries;
+    typedef std::unordered_map<Key, typename Entries::iterator, Hash> Index;
+
+    void evict() {
+        while (m_entries.size() > m_capacity) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    std::size_t m_capacity;    ///< Maximum number of entries
+    std::size_t m_hits;        ///< Number of successful lookups
+    std::size_t m_misses;      ///< Number of failed lookups
+    Entries m_entries;         ///< Entries ordered from the most to the least recently used
+    Index m_index;             ///< Key -> list node
+};
+
+#endif /* LRUCACHE_H_ */
@@ -0,0 +1,180 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+// The system headers come first: windows.h and the R headers both define ERROR
+#ifdef _WIN32
+#include <windows.h>
+#undef ERROR
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path, bool append): m_path(path), m_readOnly(false), m_size(0),
+    m_view(nullptr), m_length(0), m_mapping(nullptr) {
+    m_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                         append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+        stop("Cannot open the file %s.", path);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)) {
+        CloseHandle(m_file);
+        stop("Cannot get the size of the file %s.", path);
+    }
+    m_size = static_cast<uint64_t>(size.QuadPart);
+}
+
+MappedFile::MappedFile(const std::string& path): m_path(path), m_readOnly(true), m_size(0), m_view(nullptr),
+    m_length(0), m_mapping(nullptr) {
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+        stop("Cannot open the file %s.", path);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)) {
+        CloseHandle(m_file);
+        stop("Cannot get the size of the file %s.", path);
+    }
+    m_size = static_cast<uint64_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+    CloseHandle(m_file);
+}
+
+uint64_t MappedFile::granularity() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+char* MappedFile::map(uint64_t offset, std::size_t bytes) {
+    unmap();
+    const uint64_t end = offset + bytes;
+    if (end > m_size && m_readOnly)
+        stop("Cannot map past the end of the file %s.", m_path);
+    if (end > m_size) {
+        LARGE_INTEGER pos;
+        pos.QuadPart = static_cast<LONGLONG>(end);
+        if (!SetFilePointerEx(m_file, pos, NULL, FILE_BEGIN) || !SetEndOfFile(m_file))
+            stop("Cannot extend the file %s.", m_path);
+        m_size = end;
+    }
+    if (bytes == 0)
+        return nullptr;
+
+    m_mapping = CreateFileMappingA(m_file, NULL, m_readOnly ? PAGE_READONLY : PAGE_READWRITE,
+                                   static_cast<DWORD>(end >> 32), static_cast<DWORD>(end & 0xffffffffULL), NULL);
+    if (m_mapping == NULL)
+        stop("Cannot map the file %s.", m_path);
+    const uint64_t start = offset - offset % granularity();
+    m_length = static_cast<std::size_t>(end - start);
+    m_view = MapViewOfFile(m_mapping, m_readOnly ? FILE_MAP_READ : FILE_MAP_WRITE, static_cast<DWORD>(start >> 32),
+                           static_cast<DWORD>(start & 0xffffffffULL), m_length);
+    if (m_view == NULL) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        stop("Cannot map the file %s.", m_path);
+    }
+    return static_cast<char*>(m_view) + (offset - start);
+}
+
+void MappedFile::unmap() {
+    if (m_view) {
+        if (!m_readOnly)
+            FlushViewOfFile(m_view, m_length);
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path, bool append): m_path(path), m_readOnly(false), m_size(0),
+    m_view(nullptr), m_length(0) {
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | (append ? 0 : O_TRUNC), 0644);
+    if (m_fd < 0)
+        stop("Cannot open the file %s.", path);
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) {
+        close(m_fd);
+        stop("Cannot get the size of the file %s.", path);
+    }
+    m_size = static_cast<uint64_t>(st.st_size);
+}
+
+MappedFile::MappedFile(const std::string& path): m_path(path), m_readOnly(true), m_size(0), m_view(nullptr),
+    m_length(0) {
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+        stop("Cannot open the file %s.", path);
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) {
+        close(m_fd);
+        stop("Cannot get the size of the file %s.", path);
+    }
+    m_size = static_cast<uint64_t>(st.st_size);
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+    close(m_fd);
+}
+
+uint64_t MappedFile::granularity() {
+    return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+char* MappedFile::map(uint64_t offset, std::size_t bytes) {
+    unmap();
+    const uint64_t end = offset + bytes;
+    if (end > m_size && m_readOnly)
+        stop("Cannot map past the end of the file %s.", m_path);
+    if (end > m_size) {
+        if (ftruncate(m_fd, static_cast<off_t>(end)) != 0)
+            stop("Cannot extend the file %s.", m_path);
+        m_size = end;
+    }
+    if (bytes == 0)
+        return nullptr;
+
+    const uint64_t start = offset - offset % granularity();
+    m_length = static_cast<std::size_t>(end - start);
+    void* view = mmap(NULL, m_length, m_readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, m_fd,
+                      static_cast<off_t>(start));
+    if (view == MAP_FAILED)
+        stop("Cannot map the file %s.", m_path);
+    m_view = view;
+    return static_cast<char*>(m_view) + (offset - start);
+}
+
+void MappedFile::unmap() {
+    if (m_view) {
+        munmap(m_view, m_length);
+        m_view = nullptr;
+    }
+}
+
+#endif
+
+uint64_t MappedFile::size() const {
+    return m_size;
+}
@@ -0,0 +1,91 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief A file written or read through memory-mapped windows.
+ *
+ * A file opened for writing (truncated, or kept with append) is written one
+ * window at a time: map() grows the file to the end of the window and maps it,
+ * the caller fills the returned memory directly, and unmap() (or the next map(),
+ * or the destructor) writes it back. A file opened for reading is read the same
+ * way, through read-only windows that must lie inside the file. Only one window
+ * is mapped at a time, so the memory used does not depend on the size of the
+ * file. POSIX mmap() and the Windows file mapping API are supported.
+ */
+class MappedFile {
+
+public:
+    /**
+     * @brief Opens \p path for writing.
+     *
+     * @param path The file name.
+     * @param append If true, the current content is kept, otherwise the file is truncated.
+     * @throws Rcpp::exception if the file cannot be opened.
+     */
+    MappedFile(const std::string& path, bool append);
+
+    /**
+     * @brief Opens \p path for reading.
+     *
+     * @param path The file name.
+     * @throws Rcpp::exception if the file cannot be opened.
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Unmaps the current window and closes the file.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Returns the size of the file, in bytes.
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief Maps \p bytes bytes starting at \p offset, growing the file if needed.
+     *
+     * The bytes of a file opened for reading must not be written.
+     *
+     * @return A pointer to the mapped bytes.
+     * @throws Rcpp::exception if the file cannot be grown or mapped, or if the window
+     * ends past the end of a file opened for reading.
+     */
+    char* map(uint64_t offset, std::size_t bytes);
+
+    /**
+     * @brief Unmaps the current window, if any.
+     */
+    void unmap();
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    static uint64_t granularity();
+
+    std::string m_path;
+    bool m_readOnly;        ///< Opened for reading
+    uint64_t m_size;        ///< Current size of the file
+    void* m_view;           ///< Start of the mapped region (aligned to the granularity)
+    std::size_t m_length;   ///< Length of the mapped region
+#ifdef _WIN32
+    void* m_file;           ///< File handle
+    void* m_mapping;        ///< File mapping handle
+#else
+    int m_fd;               ///< File descriptor
+#endif
+};
+
+#endif /* MAPPEDFILE_H_ */
@@ -0,0 +1,271 @@
+/*
+ * MfpsSolver.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "MfpsSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+typedef std::vector<double> Poly;     // coefficients in increasing powers
+
+const double MfpsSolver::ENDPOINT_EPS = 1e-10;
+
+// Same inset as findSolutions(): roots closer than this to 0 or 1 are not searched for.
+static const double ENDPOINT_INSET = std::pow(std::numeric_limits<double>::epsilon(), 0.25);
+
+static const int MAX_DEPTH = 200;
+
+static double evaluate(const Poly& p, double x) {
+    double r = 0.0;
+    for (size_t i = p.size(); i-- > 0; )
+        r = r * x + p[i];
+    return r;
+}
+
+static void evaluate(const Poly& p, double x, double& fx, double& dfx) {
+    fx = 0.0;
+    dfx = 0.0;
+    for (size_t i = p.size(); i-- > 0; ) {
+        dfx = dfx * x + fx;
+        fx = fx * x + p[i];
+    }
+}
+
+static double maxAbs(const Poly& p) {
+    double m = 0.0;
+    for (size_t i = 0; i < p.size(); ++i)
+        m = std::max(m, std::fabs(p[i]));
+    return m;
+}
+
+// Drops the leading (highest power) coefficients that are zero, or negligible relative to scale.
+static void trim(Poly& p, double scale) {
+    const double eps = 64.0 * std::numeric_limits<double>::epsilon() * scale;
+    for (size_t i = 0; i < p.size(); ++i)
+        if (std::fabs(p[i]) <= eps)
+            p[i] = 0.0;
+    while (!p.empty() && p.back() == 0.0)
+        p.pop_back();
+}
+
+static Poly derivative(const Poly& p) {
+    Poly d;
+    for (size_t i = 1; i < p.size(); ++i)
+        d.push_back(i * p[i]);
+    return d;
+}
+
+// Remainder of the division of a by b (b nonzero, trimmed).
+static Poly remainder(Poly a, const Poly& b) {
+    const double scale = maxAbs(a);
+    const size_t db = b.size() - 1;
+    while (a.size() >= b.size()) {
+        const double q = a.back() / b.back();
+        const size_t shift = a.size() - b.size();
+        for (size_t i = 0; i <= db; ++i)
+            a[shift + i] -= q * b[i];
+        a.pop_back();
+    }
+    trim(a, scale);
+    return a;
+}
+
+// Sturm sequence p0 = p, p1 = p', p(i+1) = -rem(p(i-1), p(i)).
+static std::vector<Poly> sturmSequence(const Poly& p) {
+    std::vector<Poly> seq;
+    seq.push_back(p);
+    Poly d = derivative(p);
+    trim(d, maxAbs(p));
+    if (d.empty())
+        return seq;
+    seq.push_back(d);
+    while (seq.back().size() > 1) {
+        Poly r = remainder(seq[seq.size() - 2], seq.back());
+        if (r.empty())
+            break;
+        for (size_t i = 0; i < r.size(); ++i)
+            r[i] = -r[i];
+        seq.push_back(r);
+    }
+    return seq;
+}
+
+static int signVariations(const std::vector<Poly>& seq, double x) {
+    int variations = 0;
+    int last = 0;
+    for (size_t i = 0; i < seq.size(); ++i) {
+        const double v = evaluate(seq[i], x);
+        const int s = (v > 0) - (v < 0);
+        if (s == 0)
+            continue;
+        if (last != 0 && s != last)
+            ++variations;
+        last = s;
+    }
+    return variations;
+}
+
+// Number of sign changes of p on a uniform grid of [lo, hi].
+static int sampledSignChanges(const Poly& p, double lo, double hi) {
+    const int points = 16;
+    int changes = 0;
+    int last = 0;
+    for (int i = 0; i <= points; ++i) {
+        const double v = evaluate(p, lo + (hi - lo) * i / points);
+        const int s = (v > 0) - (v < 0);
+        if (s == 0)
+            continue;
+        if (last != 0 && s != last)
+            ++changes;
+        last = s;
+    }
+    return changes;
+}
+
+MfpsSolver::MfpsSolver(double tol): m_tol(tol) {
+}
+
+// Safeguarded Newton iteration on a bracket [lo, hi] with a sign change.
+static double refine(const Poly& p, double lo, double hi, double tol) {
+    double flo = evaluate(p, lo);
+    double x = 0.5 * (lo + hi);
+    for (int iter = 0; iter < 2 * MAX_DEPTH; ++iter) {
+        double fx, dfx;
+        evaluate(p, x, fx, dfx);
+        if (fx == 0.0)
+            return x;
+        if ((fx > 0) == (flo > 0)) {
+            lo = x;
+            flo = fx;
+        }
+        else
+            hi = x;
+        if (hi - lo <= tol)
+            break;
+
+        const double newton = (dfx != 0.0) ? x - fx / dfx : lo - 1.0;
+        if (newton > lo && newton < hi) {
+            // A converged Newton step is accepted once the sign change around it is verified
+            if (std::fabs(newton - x) <= 0.5 * tol) {
+                const double a = std::max(lo, newton - 0.5 * tol), b = std::min(hi, newton + 0.5 * tol);
+                const double fa = evaluate(p, a), fb = evaluate(p, b);
+                if (fa != 0.0 && fb != 0.0 && (fa > 0) != (fb > 0))
+                    return newton;
+            }
+            x = newton;
+        }
+        else
+            x = 0.5 * (lo + hi);
+    }
+    return 0.5 * (lo + hi);
+}
+
+std::vector<double> MfpsSolver::roots(const Poly& poly, double a, double b) const {
+    std::vector<double> result;
+    Poly p = poly;
+    trim(p, maxAbs(p));
+    // Roots at 0 lie outside (a, b) for a >= 0 and only degrade the conditioning
+    while (a >= 0.0 && p.size() > 1 && p[0] == 0.0)
+        p.erase(p.begin());
+    if (p.size() < 2)
+        return result;
+
+    const std::vector<Poly> seq = sturmSequence(p);
+
+    // Isolation by bisection: each stack entry is an interval with its Sturm counts
+    struct Interval { double lo, hi; int vlo, vhi, depth; };
+    std::vector<Interval> stack;
+    Interval whole = { a, b, signVariations(seq, a), signVariations(seq, b), 0 };
+    stack.push_back(whole);
+    while (!stack.empty()) {
+        Interval in = stack.back();
+        stack.pop_back();
+        const double flo = evaluate(p, in.lo), fhi = evaluate(p, in.hi);
+        const bool signChange = flo != 0.0 && fhi != 0.0 && (flo > 0) != (fhi > 0);
+
+        // The Sturm count is computed in floating point; a sign change is the ground truth
+        int count = in.vlo - in.vhi;
+        if (count <= 0 && signChange)
+            count = 1;
+        if (count == 1 && sampledSignChanges(p, in.lo, in.hi) > 1)
+            count = 2;
+        if (count <= 0)
+            continue;
+
+        if (count == 1 || in.hi - in.lo <= m_tol || in.depth >= MAX_DEPTH) {
+            // A single root without a sign change has an even multiplicity
+            if (signChange)
+                result.push_back(refine(p, in.lo, in.hi, m_tol));
+            continue;
+        }
+
+        const double mid = 0.5 * (in.lo + in.hi);
+        const int vmid = signVariations(seq, mid);
+        Interval left = { in.lo, mid, in.vlo, vmid, in.depth + 1 };
+        Interval right = { mid, in.hi, vmid, in.vhi, in.depth + 1 };
+        if (evaluate(p, mid) == 0.0) {
+            // mid is a root: keep it if p changes sign across it
+            const double h = std::max(m_tol, 1e-3 * (in.hi - in.lo));
+            const double fl = evaluate(p, mid - h), fr = evaluate(p, mid + h);
+            if ((fl > 0) != (fr > 0))
+                result.push_back(mid);
+            left.vhi = signVariations(seq, mid - h);
+            left.hi = mid - h;
+            right.lo = mid + h;
+            right.vlo = signVariations(seq, mid + h);
+        }
+        stack.push_back(left);
+        stack.push_back(right);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool MfpsSolver::solve(const Finitization& f, double& lower, double& upper) const {
+    const int n = f.getOrder();
+    Poly p;
+    if (n < 1 || !f.pmfPolynomial(n - 1, p))
+        return false;
+
+    // The endpoints are roots when the PMF is (numerically) zero there
+    const double u0 = f.seriesArgument(0.0), u1 = f.seriesArgument(1.0);
+    const double f0 = std::isfinite(u0) ? evaluate(p, u0) : std::numeric_limits<double>::quiet_NaN();
+    const double f1 = std::isfinite(u1) ? evaluate(p, u1) : std::numeric_limits<double>::quiet_NaN();
+    const bool has0 = std::isfinite(f0) && std::fabs(f0) <= ENDPOINT_EPS;
+    const bool has1 = std::isfinite(f1) && std::fabs(f1) <= ENDPOINT_EPS;
+
+    // Sign-change roots inside [inset, 1 - inset], mapped back to the parameter
+    const std::vector<double> ur = roots(p, f.seriesArgument(ENDPOINT_INSET), f.seriesArgument(1.0 - ENDPOINT_INSET));
+    std::vector<double> found;
+    if (has0)
+        found.push_back(0.0);
+    for (size_t i = 0; i < ur.size(); ++i)
+        found.push_back(f.seriesParameter(ur[i]));
+    if (has1)
+        found.push_back(1.0);
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    // The two largest roots, plus the endpoints that are roots
+    std::vector<double> all;
+    if (has0)
+        all.push_back(0.0);
+    all.insert(all.end(), found.size() > 2 ? found.end() - 2 : found.begin(), found.end());
+    if (has1)
+        all.push_back(1.0);
+
+    if (all.empty()) {
+        lower = upper = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+    lower = all.size() == 1 ? 0.0 : *std::min_element(all.begin(), all.end());
+    upper = *std::max_element(all.begin(), all.end());
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+ * MfpsSolver.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef MFPSSOLVER_H_
+#define MFPSSOLVER_H_
+
+#include <vector>
+#include "Finitization.h"
+
+/**
+ * @class MfpsSolver
+ * @brief Native solver for the maximum feasible parameter space (MFPS).
+ *
+ * The MFPS of a finitized distribution of order n is bounded by the two largest
+ * roots in [0, 1] of its PMF at x = n-1. When this PMF is a polynomial in the
+ * series argument (see Finitization::pmfPolynomial()), its real roots are
+ * isolated with a Sturm sequence and refined with a safeguarded Newton iteration.
+ * Each returned root is certified: the polynomial changes sign across an
+ * interval of width at most the solver tolerance around it.
+ *
+ * The bounds follow the rules of the R function \c findSolutions(): only roots
+ * where the PMF changes sign are kept, the endpoints 0 and 1 count as roots
+ * when \f$ |f| \le 10^{-10} \f$ there, and the lower bound is 0 when a single
+ * root is found.
+ */
+class MfpsSolver {
+
+public:
+    static const double ENDPOINT_EPS;   ///< An endpoint is a root when |f| is below this value
+
+    /**
+     * @brief Constructor.
+     *
+     * @param tol Width of the certified bracket of each root, in the series argument.
+     */
+    explicit MfpsSolver(double tol = 1e-13);
+
+    /**
+     * @brief Computes the MFPS of a finitized distribution.
+     *
+     * @param f The finitized distribution.
+     * @param lower Output lower limit of the MFPS (NaN if no root is found).
+     * @param upper Output upper limit of the MFPS (NaN if no root is found).
+     * @return false if the PMF is not a polynomial in the series argument; the
+     * bounds must then be computed by the R fallback.
+     */
+    bool solve(const Finitization& f, double& lower, double& upper) const;
+
+    /**
+     * @brief Finds the roots of odd multiplicity of a polynomial in the open interval (a, b).
+     *
+     * @param poly Coefficients, in increasing powers.
+     * @param a Left end of the interval.
+     * @param b Right end of the interval.
+     * @return The roots, in increasing order.
+     */
+    std::vector<double> roots(const std::vector<double>& poly, double a, double b) const;
+
+private:
+    double m_tol;
+};
+
+#endif /* MFPSSOLVER_H_ */
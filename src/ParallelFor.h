@@ -0,0 +1,96 @@
+/*
+ * ParallelFor.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the number of worker threads to use for a given request.
+ *
+ * A request <= 0 means "all the hardware threads". The result is never larger
+ * than the amount of work \p m and never smaller than 1.
+ *
+ * @param requested The number of threads requested by the user.
+ * @param m The number of independent work items.
+ */
+inline int resolveThreads(int requested, int m) {
+    int nthreads = requested;
+    if (nthreads <= 0) {
+        nthreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (nthreads <= 0)
+            nthreads = 1;
+    }
+    if (nthreads > m)
+        nthreads = m;
+    return nthreads < 1 ? 1 : nthreads;
+}
+
+/**
+ * @brief Splits the range [0, m) into contiguous blocks processed by worker threads.
+ *
+ * \p body is called as body(begin, end) once per block, the last block running on
+ * the calling thread. Blocks are disjoint, so workers may write to disjoint parts
+ * of a preallocated buffer without synchronization. The body must not call the R
+ * API or GiNaC. An exception thrown by a block is rethrown on the calling thread
+ * after all the workers have finished.
+ *
+ * @param m The number of work items.
+ * @param nthreads The number of threads (see resolveThreads()).
+ * @param body The function processing a block of work items.
+ */
+template<class Body>
+void parallelFor(int m, int nthreads, Body body) {
+    nthreads = resolveThreads(nthreads, m);
+    if (nthreads == 1) {
+        if (m > 0)
+            body(0, m);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(nthreads);
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads - 1);
+
+    const int chunk = m / nthreads, extra = m % nthreads;
+    int begin = 0;
+    for (int t = 0; t < nthreads; ++t) {
+        const int end = begin + chunk + (t < extra ? 1 : 0);
+        auto run = [&body, &errors, t, begin, end]() {
+            try {
+                body(begin, end);
+            }
+            catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        if (t == nthreads - 1) {
+            run();
+        }
+        else {
+            try {
+                workers.push_back(std::thread(run));
+            }
+            catch (const std::system_error&) {
+                run();      // no more threads available: process the block here
+            }
+        }
+        begin = end;
+    }
+
+    for (size_t t = 0; t < workers.size(); ++t)
+        workers[t].join();
+    for (int t = 0; t < nthreads; ++t)
+        if (errors[t])
+            std::rethrow_exception(errors[t]);
+}
+
+#endif /* PARALLELFOR_H_ */
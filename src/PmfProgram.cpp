@@ -0,0 +1,205 @@
+/*
+ * PmfProgram.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "PmfProgram.h"
+#include "Arena.h"
+#include "DoubleDouble.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// Operation codes of the instructions
+enum { CONSTANT, PARAMETER, SUM, PRODUCT, INTEGER_POWER, POWER, LOGARITHM, EXPONENTIAL };
+
+// Arithmetic of the instructions, in double and in double-double precision
+
+// The low part of a constant is only used in double-double precision
+static inline void load(double& r, double hi, double) {
+    r = hi;
+}
+
+static inline void load(DoubleDouble& r, double hi, double lo) {
+    r = DoubleDouble(hi) + DoubleDouble(lo);
+}
+
+static inline double toDouble(double x) {
+    return x;
+}
+
+static inline double toDouble(const DoubleDouble& x) {
+    return x.toDouble();
+}
+
+static inline double raise(double b, double e) {
+    return std::pow(b, e);
+}
+
+static inline DoubleDouble raise(const DoubleDouble& b, const DoubleDouble& e) {
+    return exp(e * log(b));
+}
+
+// b^k by repeated squaring
+template<typename T>
+static T integerPower(T b, int k) {
+    if (k < 0)
+        return T(1.0) / integerPower(b, -k);
+    T r(1.0);
+    while (k) {
+        if (k & 1)
+            r = r * b;
+        b = b * b;
+        k >>= 1;
+    }
+    return r;
+}
+
+PmfProgram::PmfProgram() {
+}
+
+void PmfProgram::split(const numeric& c, double& hi, double& lo) {
+    hi = c.to_double();
+    lo = 0.0;
+    if (!c.is_rational() || !std::isfinite(hi) || hi == 0.0)
+        return;
+
+    // hi = m * 2^(e - 53) exactly, the integer m being split in two halves that fit in an int
+    int e;
+    const double m = std::ldexp(std::frexp(hi, &e), 53);
+    const int upper = static_cast<int>(m / 134217728.0);
+    const int lower = static_cast<int>(m - upper * 134217728.0);
+    const numeric exact = (numeric(upper) * numeric(134217728) + numeric(lower)) * numeric(2).power(e - 53);
+    lo = (c - exact).to_double();
+}
+
+int PmfProgram::emit(const ex& e, const symbol& param, std::map<ex, int, ex_is_less>& registers) {
+    std::map<ex, int, ex_is_less>::const_iterator it = registers.find(e);
+    if (it != registers.end())
+        return it->second;
+
+    Instruction ins = { CONSTANT, 0, 0, 0.0, 0.0 };
+    std::vector<int> args;
+    if (is_a<numeric>(e)) {
+        if (!ex_to<numeric>(e).is_real())
+            return -1;
+        split(ex_to<numeric>(e), ins.hi, ins.lo);
+    } else if (is_a<constant>(e)) {
+        const ex value = e.evalf();
+        if (!is_a<numeric>(value) || !ex_to<numeric>(value).is_real())
+            return -1;
+        split(ex_to<numeric>(value), ins.hi, ins.lo);
+    } else if (is_a<symbol>(e)) {
+        if (!e.is_equal(param))
+            return -1;
+        ins.op = PARAMETER;
+    } else if (is_a<add>(e) || is_a<mul>(e)) {
+        ins.op = is_a<add>(e) ? SUM : PRODUCT;
+        for (size_t i = 0; i < e.nops(); ++i)
+            args.push_back(emit(e.op(i), param, registers));
+        ins.count = static_cast<int>(args.size());
+    } else if (is_a<power>(e)) {
+        const ex exponent = e.op(1);
+        args.push_back(emit(e.op(0), param, registers));
+        if (exponent.info(info_flags::integer) && abs(ex_to<numeric>(exponent)) < (1 << 30)) {
+            ins.op = INTEGER_POWER;
+            ins.count = ex_to<numeric>(exponent).to_int();
+        } else {
+            ins.op = POWER;
+            args.push_back(emit(exponent, param, registers));
+        }
+    } else if (is_ex_the_function(e, log) || is_ex_the_function(e, exp)) {
+        ins.op = is_ex_the_function(e, log) ? LOGARITHM : EXPONENTIAL;
+        args.push_back(emit(e.op(0), param, registers));
+    } else {
+        return -1;
+    }
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] < 0)
+            return -1;
+    }
+    ins.first = static_cast<int>(m_operands.size());
+    m_operands.insert(m_operands.end(), args.begin(), args.end());
+    m_code.push_back(ins);
+    const int r = static_cast<int>(m_code.size()) - 1;
+    registers.insert(std::make_pair(e, r));
+    return r;
+}
+
+bool PmfProgram::compile(const ex& e, const symbol& param) {
+    m_code.clear();
+    m_operands.clear();
+    std::map<ex, int, ex_is_less> registers;
+    if (emit(e, param, registers) < 0) {
+        m_code.clear();
+        m_operands.clear();
+        return false;
+    }
+    return true;
+}
+
+bool PmfProgram::isCompiled() const {
+    return !m_code.empty();
+}
+
+int PmfProgram::size() const {
+    return static_cast<int>(m_code.size());
+}
+
+template<typename T>
+T PmfProgram::run(double theta) const {
+    using std::exp;
+    using std::log;
+
+    const int size = static_cast<int>(m_code.size());
+    ScratchBuffer<T> reg(size);
+    for (int i = 0; i < size; ++i) {
+        const Instruction& ins = m_code[i];
+        const int* a = m_operands.data() + ins.first;
+        switch (ins.op) {
+        case CONSTANT:
+            load(reg[i], ins.hi, ins.lo);
+            break;
+        case PARAMETER:
+            reg[i] = T(theta);
+            break;
+        case SUM: {
+            T s = reg[a[0]];
+            for (int k = 1; k < ins.count; ++k)
+                s = s + reg[a[k]];
+            reg[i] = s;
+            break;
+        }
+        case PRODUCT: {
+            T p = reg[a[0]];
+            for (int k = 1; k < ins.count; ++k)
+                p = p * reg[a[k]];
+            reg[i] = p;
+            break;
+        }
+        case INTEGER_POWER:
+            reg[i] = integerPower(reg[a[0]], ins.count);
+            break;
+        case POWER:
+            reg[i] = raise(reg[a[0]], reg[a[1]]);
+            break;
+        case LOGARITHM:
+            reg[i] = log(reg[a[0]]);
+            break;
+        default:
+            reg[i] = exp(reg[a[0]]);
+            break;
+        }
+    }
+    return reg[size - 1];
+}
+
+double PmfProgram::evaluate(double theta, bool extended) const {
+    if (m_code.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+    return extended ? toDouble(run<DoubleDouble>(theta)) : toDouble(run<double>(theta));
+}
@@ -0,0 +1,93 @@
+/*
+ * PmfProgram.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef PMFPROGRAM_H_
+#define PMFPROGRAM_H_
+
+#include <map>
+#include <vector>
+#include <ginac/ginac.h>
+
+using namespace GiNaC;
+
+/**
+ * @class PmfProgram
+ * @brief A symbolic expression of one parameter compiled into a flat list of instructions.
+ *
+ * compile() walks the expression tree of a finitized PMF once and emits one
+ * instruction per distinct subexpression (numbers, the parameter, sums,
+ * products, powers, log and exp); a subexpression shared by several branches
+ * of the tree is computed once. evaluate() then runs the list for a value of
+ * the parameter with plain floating point arithmetic, in double or double-double
+ * precision, instead of substituting the value in the expression and evaluating
+ * it with the arbitrary precision arithmetic of CLN.
+ */
+class PmfProgram {
+
+public:
+    /**
+     * @brief Constructor. Creates an empty program, which is not compiled.
+     */
+    PmfProgram();
+
+    /**
+     * @brief Compiles \p e, a function of \p param.
+     *
+     * @param e The expression.
+     * @param param The symbol of the parameter.
+     * @return false if the expression contains another symbol or an unsupported function;
+     * the program is then left empty.
+     */
+    bool compile(const ex& e, const symbol& param);
+
+    /**
+     * @brief Tells if the program holds a compiled expression.
+     */
+    bool isCompiled() const;
+
+    /**
+     * @brief Returns the number of instructions.
+     */
+    int size() const;
+
+    /**
+     * @brief Evaluates the expression.
+     *
+     * @param theta The value of the parameter.
+     * @param extended If true, the arithmetic is carried out in double-double precision.
+     * @return The value of the expression; NaN if the program is not compiled.
+     */
+    double evaluate(double theta, bool extended = false) const;
+
+    /**
+     * @brief Splits a real number into a double and the double nearest to the rounding error.
+     *
+     * @param c The number.
+     * @param hi The double nearest to \p c.
+     * @param lo The double nearest to \p c - \p hi (0 if \p c is not rational).
+     */
+    static void split(const numeric& c, double& hi, double& lo);
+
+private:
+    struct Instruction {
+        int op;             ///< One of the operation codes
+        int first;          ///< First operand, in m_operands
+        int count;          ///< Number of operands, or the exponent of an integer power
+        double hi;          ///< Value of a constant
+        double lo;          ///< Rounding error of the value of a constant
+    };
+
+    int emit(const ex& e, const symbol& param, std::map<ex, int, ex_is_less>& registers);
+
+    template<typename T>
+    T run(double theta) const;
+
+    std::vector<Instruction> m_code;    ///< Instruction i writes register i; the result is in the last one
+    std::vector<int> m_operands;        ///< Registers read by the instructions
+};
+
+#endif /* PMFPROGRAM_H_ */
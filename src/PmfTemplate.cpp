@@ -0,0 +1,138 @@
+/*
+ * PmfTemplate.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "PmfTemplate.h"
+#include "PmfProgram.h"
+#include "DoubleDouble.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// Extracts the coefficients of a polynomial in param, and their rounding errors; returns
+// false if p is not a polynomial in param with numeric coefficients.
+static bool polynomialCoefficients(const ex& p, const symbol& param, vector<double>& coeffs, vector<double>& low) {
+    if (!p.is_polynomial(param))
+        return false;
+    const int deg = p.degree(param);
+    coeffs.assign(deg + 1, 0.0);
+    low.assign(deg + 1, 0.0);
+    for (int i = 0; i <= deg; ++i) {
+        ex c = p.coeff(param, i);
+        if (!is_a<numeric>(c))
+            return false;
+        PmfProgram::split(ex_to<numeric>(c), coeffs[i], low[i]);
+    }
+    return true;
+}
+
+// Horner's scheme, coefficients in increasing powers.
+static inline double horner(const vector<double>& c, double t) {
+    double r = 0.0;
+    for (size_t i = c.size(); i-- > 0; )
+        r = r * t + c[i];
+    return r;
+}
+
+// Horner's scheme in double-double precision, with the rounding errors of the coefficients.
+static inline DoubleDouble hornerExtended(const vector<double>& c, const vector<double>& low, double t) {
+    DoubleDouble r;
+    for (size_t i = c.size(); i-- > 0; )
+        r = r * DoubleDouble(t) + (DoubleDouble(c[i]) + DoubleDouble(low[i]));
+    return r;
+}
+
+PmfTemplate::PmfTemplate(): m_numeric(true) {
+}
+
+bool PmfTemplate::append(const ex& pdf, const symbol& param) {
+    if (!m_numeric)
+        return false;
+
+    ex nd = pdf.normal().numer_denom();
+    ex num = nd.op(0);
+    ex den = nd.op(1);
+    // A constant denominator is folded (exactly) into the numerator
+    if (is_a<numeric>(den)) {
+        num = num / den;
+        den = 1;
+    }
+
+    vector<double> numer, denom, numerLow, denomLow;
+    m_numeric = polynomialCoefficients(num.expand(), param, numer, numerLow) &&
+                polynomialCoefficients(den.expand(), param, denom, denomLow);
+
+    if (!m_numeric) {
+        m_numer.clear();
+        m_denom.clear();
+        m_numerLow.clear();
+        m_denomLow.clear();
+        return false;
+    }
+
+    if (denom.size() == 1 && denom[0] == 1.0) {
+        denom.clear();
+        denomLow.clear();
+    }
+    m_numer.push_back(numer);
+    m_denom.push_back(denom);
+    m_numerLow.push_back(numerLow);
+    m_denomLow.push_back(denomLow);
+    return true;
+}
+
+bool PmfTemplate::isNumeric() const {
+    return m_numeric;
+}
+
+int PmfTemplate::order() const {
+    return static_cast<int>(m_numer.size()) - 1;
+}
+
+double PmfTemplate::evaluate(int x, double theta, bool extended) const {
+    if (!m_numeric || x < 0 || x > order())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    if (extended) {
+        const DoubleDouble num = hornerExtended(m_numer[x], m_numerLow[x], theta);
+        if (m_denom[x].empty())
+            return num.toDouble();
+        const DoubleDouble den = hornerExtended(m_denom[x], m_denomLow[x], theta);
+        if (den.hi() == 0.0)
+            return std::numeric_limits<double>::quiet_NaN();
+        return (num / den).toDouble();
+    }
+
+    const double num = horner(m_numer[x], theta);
+    if (m_denom[x].empty())
+        return num;
+
+    const double den = horner(m_denom[x], theta);
+    if (den == 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return num / den;
+}
+
+bool PmfTemplate::evaluate(double theta, double* out, bool extended) const {
+    if (!m_numeric)
+        return false;
+    const int n = order();
+    for (int x = 0; x <= n; ++x) {
+        out[x] = evaluate(x, theta, extended);
+        if (!std::isfinite(out[x]))
+            return false;
+    }
+    return true;
+}
+
+const vector<double>& PmfTemplate::numerator(int x) const {
+    return m_numer[x];
+}
+
+const vector<double>& PmfTemplate::denominator(int x) const {
+    return m_denom[x];
+}
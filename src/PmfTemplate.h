@@ -0,0 +1,98 @@
+/*
+ * PmfTemplate.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef PMFTEMPLATE_H_
+#define PMFTEMPLATE_H_
+
+#include <vector>
+#include <ginac/ginac.h>
+
+using namespace GiNaC;
+
+/**
+ * @class PmfTemplate
+ * @brief Parameter-independent numeric form of a finitized probability mass function.
+ *
+ * The symbolic PMF of a finitized distribution, \f$ f(x; \theta) \f$ for
+ * \f$ x = 0, \ldots, n \f$, depends only on the distribution type, the
+ * finitization order and the structural parameters (N, k). When every
+ * \f$ f(x; \theta) \f$ is a rational function of \f$ \theta \f$, this class
+ * stores its numerator and denominator as plain coefficient arrays, so that
+ * the PMF can be evaluated for any parameter value with Horner's scheme and
+ * without any GiNaC call. The rounding errors of the coefficients are kept as
+ * well, for the evaluation in double-double precision.
+ */
+class PmfTemplate {
+
+public:
+    /**
+     * @brief Constructor. Creates an empty template, PMFs are added with append().
+     */
+    PmfTemplate();
+
+    /**
+     * @brief Adds the PMF of the next value of the variable (0, 1, 2, ...).
+     *
+     * If the PMF is not a rational function of \p param with numeric coefficients,
+     * the template is marked as not numeric, all stored coefficients are dropped
+     * and the template can no longer be evaluated.
+     *
+     * @param pdf Symbolic PMF of the next value of the variable.
+     * @param param Symbol of the distribution parameter.
+     * @return true if the template is still numeric.
+     */
+    bool append(const ex& pdf, const symbol& param);
+
+    /**
+     * @brief Tells if all PMFs are rational functions of the parameter.
+     */
+    bool isNumeric() const;
+
+    /**
+     * @brief Returns the finitization order n (the number of stored PMFs minus one).
+     */
+    int order() const;
+
+    /**
+     * @brief Evaluates the PMF at one value of the variable.
+     *
+     * @param x Value of the variable, in {0, ..., n}.
+     * @param theta Value of the distribution parameter.
+     * @param extended If true, Horner's scheme runs in double-double precision.
+     * @return The (raw, unclamped) PMF value; NaN if a denominator vanishes at \p theta.
+     */
+    double evaluate(int x, double theta, bool extended = false) const;
+
+    /**
+     * @brief Evaluates the PMF for all values of the variable.
+     *
+     * @param theta Value of the distribution parameter.
+     * @param out Output array of n+1 raw PMF values.
+     * @param extended If true, Horner's scheme runs in double-double precision.
+     * @return false if the template is not numeric or a value is not finite.
+     */
+    bool evaluate(double theta, double* out, bool extended = false) const;
+
+    /**
+     * @brief Returns the numerator coefficients of pdf(x), in increasing powers of the parameter.
+     */
+    const std::vector<double>& numerator(int x) const;
+
+    /**
+     * @brief Returns the denominator coefficients of pdf(x); empty when the denominator is 1.
+     */
+    const std::vector<double>& denominator(int x) const;
+
+private:
+    bool m_numeric;                               ///< true if all PMFs are rational in theta
+    std::vector< std::vector<double> > m_numer;   ///< Numerator coefficients, increasing powers of theta
+    std::vector< std::vector<double> > m_denom;   ///< Denominator coefficients; empty when the denominator is 1
+    std::vector< std::vector<double> > m_numerLow;    ///< Rounding errors of the numerator coefficients
+    std::vector< std::vector<double> > m_denomLow;    ///< Rounding errors of the denominator coefficients
+};
+
+#endif /* PMFTEMPLATE_H_ */
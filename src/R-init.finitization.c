@@ -3,26 +3,96 @@
 #include <R_ext/Rdynload.h>
 
 /* .Call calls */
+extern SEXP _finitization_c_bankInfo(SEXP);
+extern SEXP _finitization_c_cacheStats(void);
+extern SEXP _finitization_c_clearCache(void);
 extern SEXP _finitization_c_d(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_dBatch(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_distD(SEXP, SEXP);
+extern SEXP _finitization_c_distDensity(SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_distP(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_distQ(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_distR(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_distribution(SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_exportDensity(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_families(void);
+extern SEXP _finitization_c_fit(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_getEvaluationEngine(void);
+extern SEXP _finitization_c_getEvaluationPrecision(void);
+extern SEXP _finitization_c_gof(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_histogram(SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_histogramFile(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_loglik(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_mfps(SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_p(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP _finitization_c_printDensity(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_profile(void);
+extern SEXP _finitization_c_q(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_rbank(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_registerFamily(SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_resetProfile(void);
+extern SEXP _finitization_c_rstream(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_rstreamToFile(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_samplerBank(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_c_setAliasKernel(SEXP);
+extern SEXP _finitization_c_setCacheCapacity(SEXP);
+extern SEXP _finitization_c_setEvaluationEngine(SEXP);
+extern SEXP _finitization_c_setEvaluationPrecision(SEXP);
+extern SEXP _finitization_c_setProfiling(SEXP);
 extern SEXP _finitization_check_symbolic_equivalence(SEXP, SEXP);
 extern SEXP _finitization_getBinomialType(void);
+extern SEXP _finitization_getCustomType(void);
 extern SEXP _finitization_getLogarithmicType(void);
 extern SEXP _finitization_getNegativeBinomialType(void);
 extern SEXP _finitization_getPoissonType(void);
 extern SEXP _finitization_MFPS_pdf(SEXP, SEXP, SEXP);
-extern SEXP _finitization_rvalues(SEXP, SEXP, SEXP, SEXP);
+extern SEXP _finitization_rvalues(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_finitization_c_bankInfo",                 (DL_FUNC) &_finitization_c_bankInfo,                 1},
+    {"_finitization_c_cacheStats",               (DL_FUNC) &_finitization_c_cacheStats,               0},
+    {"_finitization_c_clearCache",               (DL_FUNC) &_finitization_c_clearCache,               0},
     {"_finitization_c_d",                        (DL_FUNC) &_finitization_c_d,                        4},
+    {"_finitization_c_dBatch",                   (DL_FUNC) &_finitization_c_dBatch,                   6},
+    {"_finitization_c_distD",                    (DL_FUNC) &_finitization_c_distD,                    2},
+    {"_finitization_c_distDensity",              (DL_FUNC) &_finitization_c_distDensity,              3},
+    {"_finitization_c_distP",                    (DL_FUNC) &_finitization_c_distP,                    4},
+    {"_finitization_c_distQ",                    (DL_FUNC) &_finitization_c_distQ,                    4},
+    {"_finitization_c_distR",                    (DL_FUNC) &_finitization_c_distR,                    4},
+    {"_finitization_c_distribution",             (DL_FUNC) &_finitization_c_distribution,             3},
+    {"_finitization_c_exportDensity",            (DL_FUNC) &_finitization_c_exportDensity,            4},
+    {"_finitization_c_families",                 (DL_FUNC) &_finitization_c_families,                 0},
+    {"_finitization_c_fit",                      (DL_FUNC) &_finitization_c_fit,                      7},
+    {"_finitization_c_getEvaluationEngine",      (DL_FUNC) &_finitization_c_getEvaluationEngine,      0},
+    {"_finitization_c_getEvaluationPrecision",   (DL_FUNC) &_finitization_c_getEvaluationPrecision,   0},
+    {"_finitization_c_gof",                      (DL_FUNC) &_finitization_c_gof,                      8},
+    {"_finitization_c_histogram",                (DL_FUNC) &_finitization_c_histogram,                3},
+    {"_finitization_c_histogramFile",            (DL_FUNC) &_finitization_c_histogramFile,            5},
+    {"_finitization_c_loglik",                   (DL_FUNC) &_finitization_c_loglik,                   4},
+    {"_finitization_c_mfps",                     (DL_FUNC) &_finitization_c_mfps,                     3},
+    {"_finitization_c_p",                        (DL_FUNC) &_finitization_c_p,                        6},
     {"_finitization_c_printDensity",             (DL_FUNC) &_finitization_c_printDensity,             5},
+    {"_finitization_c_profile",                  (DL_FUNC) &_finitization_c_profile,                  0},
+    {"_finitization_c_q",                        (DL_FUNC) &_finitization_c_q,                        6},
+    {"_finitization_c_rbank",                    (DL_FUNC) &_finitization_c_rbank,                    4},
+    {"_finitization_c_registerFamily",           (DL_FUNC) &_finitization_c_registerFamily,           3},
+    {"_finitization_c_resetProfile",             (DL_FUNC) &_finitization_c_resetProfile,             0},
+    {"_finitization_c_rstream",                  (DL_FUNC) &_finitization_c_rstream,                  7},
+    {"_finitization_c_rstreamToFile",            (DL_FUNC) &_finitization_c_rstreamToFile,            10},
+    {"_finitization_c_samplerBank",              (DL_FUNC) &_finitization_c_samplerBank,              4},
+    {"_finitization_c_setAliasKernel",           (DL_FUNC) &_finitization_c_setAliasKernel,           1},
+    {"_finitization_c_setCacheCapacity",         (DL_FUNC) &_finitization_c_setCacheCapacity,         1},
+    {"_finitization_c_setEvaluationEngine",      (DL_FUNC) &_finitization_c_setEvaluationEngine,      1},
+    {"_finitization_c_setEvaluationPrecision",   (DL_FUNC) &_finitization_c_setEvaluationPrecision,   1},
+    {"_finitization_c_setProfiling",             (DL_FUNC) &_finitization_c_setProfiling,             1},
     {"_finitization_check_symbolic_equivalence", (DL_FUNC) &_finitization_check_symbolic_equivalence, 2},
     {"_finitization_getBinomialType",            (DL_FUNC) &_finitization_getBinomialType,            0},
+    {"_finitization_getCustomType",              (DL_FUNC) &_finitization_getCustomType,              0},
     {"_finitization_getLogarithmicType",         (DL_FUNC) &_finitization_getLogarithmicType,         0},
     {"_finitization_getNegativeBinomialType",    (DL_FUNC) &_finitization_getNegativeBinomialType,    0},
     {"_finitization_getPoissonType",             (DL_FUNC) &_finitization_getPoissonType,             0},
     {"_finitization_MFPS_pdf",                   (DL_FUNC) &_finitization_MFPS_pdf,                   3},
-    {"_finitization_rvalues",                    (DL_FUNC) &_finitization_rvalues,                    4},
+    {"_finitization_rvalues",                    (DL_FUNC) &_finitization_rvalues,                    6},
     {NULL, NULL, 0}
 };
 
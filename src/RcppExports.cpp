@@ -25,6 +25,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// c_exportDensity
+SEXP c_exportDensity(int n, Rcpp::List const& params, int dtype, int format);
+RcppExport SEXP _finitization_c_exportDensity(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP formatSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< int >::type format(formatSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_exportDensity(n, params, dtype, format));
+    return rcpp_result_gen;
+END_RCPP
+}
 // c_d
 NumericVector c_d(int n, IntegerVector val, Rcpp::List const& params, int dtype);
 RcppExport SEXP _finitization_c_d(SEXP nSEXP, SEXP valSEXP, SEXP paramsSEXP, SEXP dtypeSEXP) {
@@ -39,17 +53,323 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// c_p
+NumericVector c_p(int n, IntegerVector val, Rcpp::List const& params, int dtype, bool lower_tail, bool log_p);
+RcppExport SEXP _finitization_c_p(SEXP nSEXP, SEXP valSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP lower_tailSEXP, SEXP log_pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type val(valSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< bool >::type lower_tail(lower_tailSEXP);
+    Rcpp::traits::input_parameter< bool >::type log_p(log_pSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_p(n, val, params, dtype, lower_tail, log_p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_q
+IntegerVector c_q(int n, NumericVector p, Rcpp::List const& params, int dtype, bool lower_tail, bool log_p);
+RcppExport SEXP _finitization_c_q(SEXP nSEXP, SEXP pSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP lower_tailSEXP, SEXP log_pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type p(pSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< bool >::type lower_tail(lower_tailSEXP);
+    Rcpp::traits::input_parameter< bool >::type log_p(log_pSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_q(n, p, params, dtype, lower_tail, log_p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_dBatch
+NumericMatrix c_dBatch(int n, NumericVector theta, IntegerVector size, int dtype, bool cdf, int nthreads);
+RcppExport SEXP _finitization_c_dBatch(SEXP nSEXP, SEXP thetaSEXP, SEXP sizeSEXP, SEXP dtypeSEXP, SEXP cdfSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type theta(thetaSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type size(sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< bool >::type cdf(cdfSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_dBatch(n, theta, size, dtype, cdf, nthreads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rvalues
-IntegerVector rvalues(int n, Rcpp::List const& params, int no, int dtype);
-RcppExport SEXP _finitization_rvalues(SEXP nSEXP, SEXP paramsSEXP, SEXP noSEXP, SEXP dtypeSEXP) {
+IntegerVector rvalues(int n, Rcpp::List const& params, int no, int dtype, int nthreads, int sampler);
+RcppExport SEXP _finitization_rvalues(SEXP nSEXP, SEXP paramsSEXP, SEXP noSEXP, SEXP dtypeSEXP, SEXP nthreadsSEXP, SEXP samplerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type no(noSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< int >::type sampler(samplerSEXP);
+    rcpp_result_gen = Rcpp::wrap(rvalues(n, params, no, dtype, nthreads, sampler));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_rstream
+IntegerVector c_rstream(int n, Rcpp::List const& params, int dtype, int no, Nullable<CharacterVector> state, int nthreads, int sampler);
+RcppExport SEXP _finitization_c_rstream(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP noSEXP, SEXP stateSEXP, SEXP nthreadsSEXP, SEXP samplerSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< int >::type n(nSEXP);
     Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
     Rcpp::traits::input_parameter< int >::type no(noSEXP);
+    Rcpp::traits::input_parameter< Nullable<CharacterVector> >::type state(stateSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< int >::type sampler(samplerSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_rstream(n, params, dtype, no, state, nthreads, sampler));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_rstreamToFile
+CharacterVector c_rstreamToFile(int n, Rcpp::List const& params, int dtype, double no, std::string file, Nullable<CharacterVector> state, bool append, double chunk, int nthreads, int sampler);
+RcppExport SEXP _finitization_c_rstreamToFile(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP noSEXP, SEXP fileSEXP, SEXP stateSEXP, SEXP appendSEXP, SEXP chunkSEXP, SEXP nthreadsSEXP, SEXP samplerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< double >::type no(noSEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< Nullable<CharacterVector> >::type state(stateSEXP);
+    Rcpp::traits::input_parameter< bool >::type append(appendSEXP);
+    Rcpp::traits::input_parameter< double >::type chunk(chunkSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< int >::type sampler(samplerSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_rstreamToFile(n, params, dtype, no, file, state, append, chunk, nthreads, sampler));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_samplerBank
+SEXP c_samplerBank(IntegerVector n, NumericVector theta, IntegerVector size, int dtype);
+RcppExport SEXP _finitization_c_samplerBank(SEXP nSEXP, SEXP thetaSEXP, SEXP sizeSEXP, SEXP dtypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type n(nSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type theta(thetaSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type size(sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_samplerBank(n, theta, size, dtype));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_rbank
+IntegerVector c_rbank(SEXP bank, IntegerVector index, Nullable<CharacterVector> state, int nthreads);
+RcppExport SEXP _finitization_c_rbank(SEXP bankSEXP, SEXP indexSEXP, SEXP stateSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type bank(bankSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< Nullable<CharacterVector> >::type state(stateSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_rbank(bank, index, state, nthreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_bankInfo
+List c_bankInfo(SEXP bank);
+RcppExport SEXP _finitization_c_bankInfo(SEXP bankSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type bank(bankSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_bankInfo(bank));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distribution
+SEXP c_distribution(int n, Rcpp::List const& params, int dtype);
+RcppExport SEXP _finitization_c_distribution(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distribution(n, params, dtype));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distD
+NumericVector c_distD(SEXP handle, IntegerVector val);
+RcppExport SEXP _finitization_c_distD(SEXP handleSEXP, SEXP valSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type val(valSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distD(handle, val));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distP
+NumericVector c_distP(SEXP handle, IntegerVector val, bool lower_tail, bool log_p);
+RcppExport SEXP _finitization_c_distP(SEXP handleSEXP, SEXP valSEXP, SEXP lower_tailSEXP, SEXP log_pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type val(valSEXP);
+    Rcpp::traits::input_parameter< bool >::type lower_tail(lower_tailSEXP);
+    Rcpp::traits::input_parameter< bool >::type log_p(log_pSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distP(handle, val, lower_tail, log_p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distQ
+IntegerVector c_distQ(SEXP handle, NumericVector p, bool lower_tail, bool log_p);
+RcppExport SEXP _finitization_c_distQ(SEXP handleSEXP, SEXP pSEXP, SEXP lower_tailSEXP, SEXP log_pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type p(pSEXP);
+    Rcpp::traits::input_parameter< bool >::type lower_tail(lower_tailSEXP);
+    Rcpp::traits::input_parameter< bool >::type log_p(log_pSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distQ(handle, p, lower_tail, log_p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distR
+IntegerVector c_distR(SEXP handle, int no, int nthreads, int sampler);
+RcppExport SEXP _finitization_c_distR(SEXP handleSEXP, SEXP noSEXP, SEXP nthreadsSEXP, SEXP samplerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< int >::type no(noSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< int >::type sampler(samplerSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distR(handle, no, nthreads, sampler));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_distDensity
+StringVector c_distDensity(SEXP handle, IntegerVector val, bool latex);
+RcppExport SEXP _finitization_c_distDensity(SEXP handleSEXP, SEXP valSEXP, SEXP latexSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type val(valSEXP);
+    Rcpp::traits::input_parameter< bool >::type latex(latexSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_distDensity(handle, val, latex));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_fit
+List c_fit(int n, Rcpp::List const& params, int dtype, NumericVector counts, double lower, double upper, int method);
+RcppExport SEXP _finitization_c_fit(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP countsSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP methodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type counts(countsSEXP);
+    Rcpp::traits::input_parameter< double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_fit(n, params, dtype, counts, lower, upper, method));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_histogram
+NumericVector c_histogram(SEXP x, int n, int nthreads);
+RcppExport SEXP _finitization_c_histogram(SEXP xSEXP, SEXP nSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_histogram(x, n, nthreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_histogramFile
+NumericVector c_histogramFile(std::string file, int n, bool binary, double chunk, int nthreads);
+RcppExport SEXP _finitization_c_histogramFile(SEXP fileSEXP, SEXP nSEXP, SEXP binarySEXP, SEXP chunkSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< bool >::type binary(binarySEXP);
+    Rcpp::traits::input_parameter< double >::type chunk(chunkSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_histogramFile(file, n, binary, chunk, nthreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_loglik
+double c_loglik(int n, Rcpp::List const& params, int dtype, NumericVector counts);
+RcppExport SEXP _finitization_c_loglik(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP countsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type counts(countsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_loglik(n, params, dtype, counts));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_gof
+List c_gof(int n, Rcpp::List const& params, int dtype, NumericVector counts, int test, int estimated, int B, int nthreads);
+RcppExport SEXP _finitization_c_gof(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP, SEXP countsSEXP, SEXP testSEXP, SEXP estimatedSEXP, SEXP BSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
-    rcpp_result_gen = Rcpp::wrap(rvalues(n, params, no, dtype));
+    Rcpp::traits::input_parameter< NumericVector >::type counts(countsSEXP);
+    Rcpp::traits::input_parameter< int >::type test(testSEXP);
+    Rcpp::traits::input_parameter< int >::type estimated(estimatedSEXP);
+    Rcpp::traits::input_parameter< int >::type B(BSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_gof(n, params, dtype, counts, test, estimated, B, nthreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_registerFamily
+int c_registerFamily(std::string name, std::string pgf, Rcpp::List const& constants);
+RcppExport SEXP _finitization_c_registerFamily(SEXP nameSEXP, SEXP pgfSEXP, SEXP constantsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< std::string >::type pgf(pgfSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type constants(constantsSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_registerFamily(name, pgf, constants));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_families
+List c_families();
+RcppExport SEXP _finitization_c_families() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(c_families());
     return rcpp_result_gen;
 END_RCPP
 }
@@ -66,6 +386,131 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// c_mfps
+NumericVector c_mfps(int n, Rcpp::List const& params, int dtype);
+RcppExport SEXP _finitization_c_mfps(SEXP nSEXP, SEXP paramsSEXP, SEXP dtypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< int >::type dtype(dtypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_mfps(n, params, dtype));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_cacheStats
+List c_cacheStats();
+RcppExport SEXP _finitization_c_cacheStats() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(c_cacheStats());
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_clearCache
+void c_clearCache();
+RcppExport SEXP _finitization_c_clearCache() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    c_clearCache();
+    return R_NilValue;
+END_RCPP
+}
+// c_setCacheCapacity
+void c_setCacheCapacity(int capacity);
+RcppExport SEXP _finitization_c_setCacheCapacity(SEXP capacitySEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type capacity(capacitySEXP);
+    c_setCacheCapacity(capacity);
+    return R_NilValue;
+END_RCPP
+}
+// c_profile
+List c_profile();
+RcppExport SEXP _finitization_c_profile() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(c_profile());
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_resetProfile
+void c_resetProfile();
+RcppExport SEXP _finitization_c_resetProfile() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    c_resetProfile();
+    return R_NilValue;
+END_RCPP
+}
+// c_setProfiling
+bool c_setProfiling(bool enabled);
+RcppExport SEXP _finitization_c_setProfiling(SEXP enabledSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type enabled(enabledSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_setProfiling(enabled));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_setEvaluationEngine
+int c_setEvaluationEngine(int engine);
+RcppExport SEXP _finitization_c_setEvaluationEngine(SEXP engineSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type engine(engineSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_setEvaluationEngine(engine));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_getEvaluationEngine
+int c_getEvaluationEngine();
+RcppExport SEXP _finitization_c_getEvaluationEngine() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(c_getEvaluationEngine());
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_setEvaluationPrecision
+int c_setEvaluationPrecision(int precision);
+RcppExport SEXP _finitization_c_setEvaluationPrecision(SEXP precisionSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type precision(precisionSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_setEvaluationPrecision(precision));
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_getEvaluationPrecision
+int c_getEvaluationPrecision();
+RcppExport SEXP _finitization_c_getEvaluationPrecision() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(c_getEvaluationPrecision());
+    return rcpp_result_gen;
+END_RCPP
+}
+// c_setAliasKernel
+int c_setAliasKernel(int kernel);
+RcppExport SEXP _finitization_c_setAliasKernel(SEXP kernelSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type kernel(kernelSEXP);
+    rcpp_result_gen = Rcpp::wrap(c_setAliasKernel(kernel));
+    return rcpp_result_gen;
+END_RCPP
+}
 // getPoissonType
 int getPoissonType();
 RcppExport SEXP _finitization_getPoissonType() {
@@ -106,6 +551,16 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// getCustomType
+int getCustomType();
+RcppExport SEXP _finitization_getCustomType() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(getCustomType());
+    return rcpp_result_gen;
+END_RCPP
+}
 // check_symbolic_equivalence
 bool check_symbolic_equivalence(std::string expr1_str, std::string expr2_str);
 RcppExport SEXP _finitization_check_symbolic_equivalence(SEXP expr1_strSEXP, SEXP expr2_strSEXP) {
@@ -0,0 +1,80 @@
+/*
+ * SamplerBank.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#include "SamplerBank.h"
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+using namespace Rcpp;
+
+SamplerBank::SamplerBank(const std::vector<DistributionKey>& keys) {
+    const int M = static_cast<int>(keys.size());
+    m_offset.resize(M + 1);
+    m_offset[0] = 0;
+    for (int d = 0; d < M; ++d)
+        m_offset[d + 1] = m_offset[d] + keys[d].n + 1;
+    m_cutoff.resize(m_offset[M]);
+    m_alias.resize(m_offset[M]);
+
+    // Repeated distributions are built once and their tables copied
+    std::unordered_map<DistributionKey, int, DistributionKeyHash> built;
+    for (int d = 0; d < M; ++d) {
+        std::unordered_map<DistributionKey, int, DistributionKeyHash>::const_iterator it = built.find(keys[d]);
+        if (it != built.end()) {
+            const int from = m_offset[it->second];
+            std::copy(m_cutoff.begin() + from, m_cutoff.begin() + m_offset[it->second + 1],
+                      m_cutoff.begin() + m_offset[d]);
+            std::copy(m_alias.begin() + from, m_alias.begin() + m_offset[it->second + 1],
+                      m_alias.begin() + m_offset[d]);
+            continue;
+        }
+        std::unique_ptr<Finitization> f = newFinitization(keys[d]);
+        if (!f)
+            stop("Unsupported distribution type %d.", keys[d].dtype);
+        f->aliasTables(&m_cutoff[m_offset[d]], &m_alias[m_offset[d]]);
+        built[keys[d]] = d;
+    }
+}
+
+void SamplerBank::sample(ValueStream& stream, const int* index, std::size_t count, int nthreads, int* out) const {
+    const int M = size();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (index[i] < 0 || index[i] >= M)
+            stop("Distribution index %d out of range.", index[i]);
+    }
+
+    const int* offset = m_offset.data();
+    const double* cutoff = m_cutoff.data();
+    const int* alias = m_alias.data();
+    stream.generate(count, nthreads, [=](Xoshiro256& g, std::size_t from, int n) {
+        for (int i = 0; i < n; ++i) {
+            const int d = index[from + i];
+            const int o = offset[d];
+            const uint32_t last = static_cast<uint32_t>(offset[d + 1] - o - 1);
+            // Same operations as the scalar alias kernel
+            const double uK = g.nextDouble() * static_cast<double>(last + 1);
+            uint32_t j = (uint32_t)uK;
+            if (j > last)
+                j = last;
+            const double f = uK - (double)j;
+            out[from + i] = (f < cutoff[o + j]) ? (int)j : alias[o + j];
+        }
+    });
+}
+
+int SamplerBank::size() const {
+    return static_cast<int>(m_offset.size()) - 1;
+}
+
+int SamplerBank::order(int d) const {
+    return m_offset[d + 1] - m_offset[d] - 1;
+}
+
+std::size_t SamplerBank::bytes() const {
+    return m_offset.size() * sizeof(int) + m_cutoff.size() * sizeof(double) + m_alias.size() * sizeof(int);
+}
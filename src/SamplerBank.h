@@ -0,0 +1,65 @@
+/*
+ * SamplerBank.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef SAMPLERBANK_H_
+#define SAMPLERBANK_H_
+
+#include <cstddef>
+#include <vector>
+#include "FinitizationCache.h"
+#include "ValueStream.h"
+
+/**
+ * @class SamplerBank
+ * @brief Alias tables of many finitized distributions stored in one arena.
+ *
+ * The tables are kept as structure of arrays: the cutoffs and the alias indices
+ * of all the distributions are concatenated in two contiguous arrays, and the
+ * distribution d occupies the positions offset(d) .. offset(d + 1) - 1. A single
+ * call draws one value per element of an index vector, each from the
+ * distribution it designates, in parallel if requested. A draw uses the same
+ * arithmetic as the alias sampler of Finitization, so a distribution of the bank
+ * gives the values of the "alias" method for the same uniforms.
+ */
+class SamplerBank {
+
+public:
+    /**
+     * @brief Builds the tables of the distributions described by \p keys.
+     *
+     * Each distinct distribution is constructed once; the objects are not kept
+     * after their tables are copied, and they do not go through the cache of
+     * finitized distributions.
+     *
+     * @param keys The distribution types, orders and parameters.
+     * @throws Rcpp::exception if a distribution type is unsupported.
+     */
+    explicit SamplerBank(const std::vector<DistributionKey>& keys);
+
+    /**
+     * @brief Draws one value from each distribution designated by \p index.
+     *
+     * @param stream The stream of random values, advanced past the draws.
+     * @param index The distributions of the draws, in 0 .. size() - 1.
+     * @param count The number of draws.
+     * @param nthreads Number of threads (<= 0 uses all the hardware threads).
+     * @param out The output array of \p count values.
+     * @throws Rcpp::exception if an index is out of range.
+     */
+    void sample(ValueStream& stream, const int* index, std::size_t count, int nthreads, int* out) const;
+
+    int size() const;                   ///< Number of distributions
+    int order(int d) const;             ///< Finitization order of distribution d
+    std::size_t bytes() const;          ///< Size of the tables in bytes
+
+private:
+    std::vector<int> m_offset;          ///< Start of each distribution in the arrays, plus the total size
+    std::vector<double> m_cutoff;       ///< Cutoffs of the alias method
+    std::vector<int> m_alias;           ///< Alias indices
+};
+
+#endif /* SAMPLERBANK_H_ */
@@ -0,0 +1,37 @@
+#ifndef SAMPLERTYPE_H_
+#define SAMPLERTYPE_H_
+
+/**
+ * @class SamplerType
+ * @brief Constants identifying the methods used to generate random values.
+ *
+ * The values follow the order of the names accepted by the R option
+ * \c finitization.sampler: "auto", "alias", "ladder", "inversion", "compact",
+ * "compact16", "calibrated".
+ */
+class SamplerType {
+
+public:
+    // Alias method for supports larger than 8 points, ladder method otherwise
+    static const int AUTO = 0;
+
+    // Walker/Vose alias method (see AliasKernel)
+    static const int ALIAS = 1;
+
+    // Branch-free comparisons against the CDF sorted by decreasing probability
+    static const int LADDER = 2;
+
+    // Binary search in the CDF
+    static const int INVERSION = 3;
+
+    // Alias method on 8-byte buckets with 32-bit cutoffs (see CompactAliasTable)
+    static const int COMPACT = 4;
+
+    // Alias method on 4-byte buckets with 16-bit cutoffs, for fewer than 65536 points
+    static const int COMPACT16 = 5;
+
+    // As AUTO, but the fastest method found by a timing run for supports of at most 8 points (not reproducible)
+    static const int CALIBRATED = 6;
+};
+
+#endif /* SAMPLERTYPE_H_ */
@@ -0,0 +1,118 @@
+/*
+ * ValueStream.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef VALUESTREAM_H_
+#define VALUESTREAM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "ParallelFor.h"
+#include "Xoshiro256.h"
+
+/**
+ * @class ValueStream
+ * @brief Resumable position in a sequence of random values drawn in independent blocks.
+ *
+ * The sequence is made of blocks of BLOCK values, block b being drawn from the
+ * seed state advanced by b calls of Xoshiro256::jump(), as in
+ * Finitization::rvalues(no, nthreads, sampler). The stream keeps the generator
+ * of the block in progress, the number of values left in it and the state of the
+ * next block, so that the values do not depend on how the sequence is split into
+ * chunks nor on the number of threads. The state can be saved as WORDS 64-bit
+ * words and restored later, e.g. to resume a simulation in another R session.
+ */
+class ValueStream {
+
+public:
+    static const int WORDS = 9;        ///< Number of 64-bit words of a saved state
+    static const int BLOCK = 65536;    ///< Number of values per independent block
+
+    /**
+     * @brief Starts a stream whose first block is drawn from a generator seeded with \p seed.
+     */
+    explicit ValueStream(uint64_t seed): m_current(seed), m_next(seed), m_remaining(0) {
+    }
+
+    /**
+     * @brief Restores a stream saved with save().
+     *
+     * @param words The WORDS words of the state.
+     */
+    explicit ValueStream(const uint64_t* words) {
+        m_current.setState(words);
+        m_next.setState(words + 4);
+        m_remaining = words[8];
+    }
+
+    /**
+     * @brief Saves the state of the stream to \p words (WORDS elements).
+     */
+    void save(uint64_t* words) const {
+        m_current.getState(words);
+        m_next.getState(words + 4);
+        words[8] = m_remaining;
+    }
+
+    /**
+     * @brief Generates the next \p count values of the stream.
+     *
+     * The values are produced by \p fill, called as fill(g, from, n) to generate
+     * the values from..from + n - 1 of this request by n successive uses of the
+     * generator g. The whole blocks are distributed over \p nthreads threads, so
+     * \p fill must not call the R API.
+     *
+     * @param count Number of values to generate.
+     * @param nthreads Number of threads (<= 0 uses all the hardware threads).
+     * @param fill The function generating the values.
+     */
+    template<class Fill>
+    void generate(std::size_t count, int nthreads, Fill fill) {
+        // The rest of the block in progress
+        std::size_t done = std::min<std::size_t>(count, m_remaining);
+        if (done > 0)
+            fill(m_current, 0, static_cast<int>(done));
+        m_remaining -= done;
+
+        // Whole blocks, each from its own jump of the stream
+        const std::size_t whole = (count - done) / BLOCK;
+        if (whole > 0) {
+            const Xoshiro256 first = m_next;
+            const std::size_t offset = done;
+            parallelFor(static_cast<int>(whole), nthreads, [&first, &fill, offset](int begin, int end) {
+                Xoshiro256 block = first;
+                for (int b = 0; b < begin; ++b)
+                    block.jump();
+                for (int b = begin; b < end; ++b) {
+                    Xoshiro256 g = block;
+                    fill(g, offset + static_cast<std::size_t>(b) * BLOCK, BLOCK);
+                    block.jump();
+                }
+            });
+            for (std::size_t b = 0; b < whole; ++b)
+                m_next.jump();
+            done += whole * BLOCK;
+        }
+
+        // The beginning of a new block
+        if (done < count) {
+            m_current = m_next;
+            m_next.jump();
+            const std::size_t tail = count - done;
+            fill(m_current, done, static_cast<int>(tail));
+            m_remaining = BLOCK - tail;
+        }
+    }
+
+private:
+
+    Xoshiro256 m_current;    ///< Generator of the block in progress
+    Xoshiro256 m_next;       ///< Initial state of the next block
+    uint64_t m_remaining;    ///< Number of values left in the block in progress
+};
+
+#endif /* VALUESTREAM_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Xoshiro256.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Bogdan Oancea
+ */
+
+#ifndef XOSHIRO256_H_
+#define XOSHIRO256_H_
+
+#include <cstdint>
+
+/**
+ * @class Xoshiro256
+ * @brief The xoshiro256++ pseudo-random number generator (Blackman and Vigna).
+ *
+ * A small, fast generator with a period of 2^256 - 1 and a jump() function that
+ * advances the state by 2^128 steps. Successive jumps of the same state give
+ * non-overlapping streams that can be used by different threads. The state is
+ * initialized from a 64-bit seed with the SplitMix64 generator, as recommended
+ * by the authors.
+ */
+class Xoshiro256 {
+
+public:
+    /**
+     * @brief Constructs a generator seeded with \p seed.
+     */
+    explicit Xoshiro256(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    /**
+     * @brief Reinitializes the state from a 64-bit seed.
+     */
+    void seed(uint64_t seed) {
+        for (int i = 0; i < 4; ++i)
+            m_s[i] = splitMix64(seed);
+    }
+
+    /**
+     * @brief Copies the four words of the state to \p words.
+     */
+    void getState(uint64_t* words) const {
+        for (int i = 0; i < 4; ++i)
+            words[i] = m_s[i];
+    }
+
+    /**
+     * @brief Restores a state saved with getState().
+     */
+    void setState(const uint64_t* words) {
+        for (int i = 0; i < 4; ++i)
+            m_s[i] = words[i];
+    }
+
+    /**
+     * @brief Returns the next 64-bit output.
+     */
+    uint64_t next() {
+        const uint64_t result = rotl(m_s[0] + m_s[3], 23) + m_s[0];
+        const uint64_t t = m_s[1] << 17;
+
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Returns a uniform double in [0, 1) with 53 random bits.
+     */
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Advances the state by 2^128 calls of next().
+     */
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (JUMP[i] & (UINT64_C(1) << b)) {
+                    s0 ^= m_s[0];
+                    s1 ^= m_s[1];
+                    s2 ^= m_s[2];
+                    s3 ^= m_s[3];
+                }
+                next();
+            }
+        }
+        m_s[0] = s0;
+        m_s[1] = s1;
+        m_s[2] = s2;
+        m_s[3] = s3;
+    }
+
+private:
+    static inline uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t m_s[4];
+};
+
+#endif /* XOSHIRO256_H_ */
@@ -1,10 +1,30 @@
 #include <Rcpp.h>
 #include <string>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include "FinitizedLogarithmicDistribution.h"
 #include "FinitizedPoissonDistribution.h"
 #include "FinitizedBinomialDistribution.h"
 #include "FinitizedNegativeBinomialDistribution.h"
 #include "DistributionType.h"
+#include "FinitizationCache.h"
+#include "EvaluationEngine.h"
+#include "AliasKernel.h"
+#include "BatchEvaluation.h"
+#include "MfpsSolver.h"
+#include "PmfTemplate.h"
+#include "Instrumentation.h"
+#include "MappedFile.h"
+#include "ValueStream.h"
+#include "SamplerBank.h"
+#include "LikelihoodFitter.h"
+#include "Histogram.h"
+#include "GoodnessOfFit.h"
+#include "GofTest.h"
+#include "FamilyRegistry.h"
 #include <ginac/ginac.h>
 #include <cln/float.h>
 
@@ -13,6 +33,65 @@ using namespace std;
 using namespace Rcpp;
 using namespace GiNaC;
 
+// Fills the cache key of the distribution described by dtype and params.
+// When symbolic is true only the structural parameters (N, k) are required,
+// and theta gets a placeholder value that is valid for the distribution.
+static bool getDistributionKey(int n, Rcpp::List const &params, int dtype, bool symbolic, DistributionKey &key) {
+    switch(dtype) {
+    case DistributionType::POISSON:
+        if(symbolic) {
+            key = DistributionKey(dtype, n, 0.0);
+            return true;
+        }
+        if(params.containsElementNamed("theta")) {
+            key = DistributionKey(dtype, n, Rcpp::as < double >( params["theta"]));
+            return true;
+        }
+        break;
+    case DistributionType::LOGARITHMIC:
+        if(symbolic) {
+            key = DistributionKey(dtype, n, 0.01);
+            return true;
+        }
+        if(params.containsElementNamed("theta")) {
+            key = DistributionKey(dtype, n, Rcpp::as < double >( params["theta"]));
+            return true;
+        }
+        break;
+    case DistributionType::BINOMIAL:
+        if(params.containsElementNamed("N") && (symbolic || params.containsElementNamed("p"))) {
+            double p = symbolic ? 0.0 : Rcpp::as < double >( params["p"]);
+            key = DistributionKey(dtype, n, p, Rcpp::as < int >( params["N"]));
+            return true;
+        }
+        else
+            Rcerr << "Binomial distribution parameter(s) not provided!" << endl;
+        break;
+    case DistributionType::NEGATIVEBINOMIAL:
+        if(params.containsElementNamed("k") && (symbolic || params.containsElementNamed("q"))) {
+            double q = symbolic ? 0.0 : Rcpp::as < double >( params["q"]);
+            key = DistributionKey(dtype, n, q, Rcpp::as < int >( params["k"]));
+            return true;
+        }
+        else
+            Rcerr << "Negative Binomial distribution parameter(s) not provided!" << endl;
+        break;
+    case DistributionType::CUSTOM:
+        // The family identifier is the size parameter; theta is a placeholder for the symbolic PMF
+        if(params.containsElementNamed("family") && (symbolic || params.containsElementNamed("theta"))) {
+            double theta = symbolic ? 0.01 : Rcpp::as < double >( params["theta"]);
+            key = DistributionKey(dtype, n, theta, Rcpp::as < int >( params["family"]));
+            return true;
+        }
+        else
+            Rcerr << "User-defined family or parameter not provided!" << endl;
+        break;
+    default:
+        Rcerr << " Distribution type unsupported!" << endl;
+    }
+    return false;
+}
+
  //' Generate string representation of a finitized probability density function
  //'
  //' This function produces symbolic string representations of the probability
@@ -45,46 +124,65 @@ using namespace GiNaC;
  // [[Rcpp::export]]
 StringVector c_printDensity(int n, IntegerVector val, Rcpp::List const &params, int dtype, bool latex = false) {
 
-    Finitization* f = nullptr;
     StringVector result(val.size());
-    double N, k;
-
-    switch(dtype) {
-    case DistributionType::POISSON:
-        f = new FinitizedPoissonDistribution(n, 0.0);
-        break;
-    case DistributionType::LOGARITHMIC:
-        f = new FinitizedLogarithmicDistribution(n, 0.01);
-        break;
-    case DistributionType::BINOMIAL:
-        if(params.containsElementNamed("N")) {
-            N = Rcpp::as < int >( params["N"]);
-            f = new FinitizedBinomialDistribution(n, 0.0, N);
-        }
-        else
-            Rcerr << "Parameter N of the Binomial distribution not provided!" << endl;
-        break;
-
-    case DistributionType::NEGATIVEBINOMIAL:
-        if(params.containsElementNamed("k")) {
-            k = Rcpp::as < int >( params["k"]);
-            f = new FinitizedNegativeBinomialDistribution(n, 0.0, k);
-        }
-        else
-            Rcerr << "Parameter k of the Negative Binomial distribution not provided!" << endl;
-        break;
-    default:
-        Rcerr << " Distribution type unsupported!" << endl;
-    }
+    DistributionKey key;
 
-    if(f) {
+    if(getDistributionKey(n, params, dtype, true, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
         for(int i = 0; i < val.size(); ++i) {
             result[i] =  f->pdfToString(val[i], latex);
         }
-        delete f;
     }
     return result;
 
+}
+
+ //' Export the finitized PMF for all the support points
+ //'
+ //' This function computes the symbolic PMF of a finitized distribution for \code{x = 0, ..., n} in a single
+ //' sweep of derivatives and returns it as plain-text expressions, LaTeX strings or, for the distributions whose
+ //' PMF is a rational function of the parameter, as numerator and denominator coefficients.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param params A named list of distribution-specific parameters:\cr
+ //'   - Binomial: \code{list(N = trials)}\cr
+ //'   - Negative Binomial: \code{list(k = dispersion)}
+ //' @param dtype An integer code representing the distribution type.
+ //' @param format 0 for R expressions, 1 for LaTeX strings, 2 for coefficient lists.
+ //'
+ //' @return For the formats 0 and 1, a \code{StringVector} with n + 1 elements. For the format 2, a list with
+ //'   n + 1 elements, each a list with the numeric vectors \code{numerator} and \code{denominator} (coefficients
+ //'   in increasing powers of the parameter), or \code{NULL} elements if the PMF is not rational in the parameter.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_exportDensity(n = 2, params = list(N = 4), dtype = getBinomialType(), format = 0)
+ //'
+ // [[Rcpp::export]]
+SEXP c_exportDensity(int n, Rcpp::List const &params, int dtype, int format = 0) {
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, true, key))
+        return R_NilValue;
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+
+    if (format == 2) {
+        List result(n + 1);
+        std::shared_ptr<const PmfTemplate> tpl = FinitizationCache::instance().getTemplate(*f);
+        if (tpl) {
+            for (int x = 0; x <= n; ++x) {
+                const std::vector<double>& denom = tpl->denominator(x);
+                result[x] = List::create(Named("numerator") = tpl->numerator(x),
+                                         Named("denominator") = denom.empty() ? std::vector<double>(1, 1.0) : denom);
+            }
+        }
+        return result;
+    }
+
+    const std::vector<ex> pmfs = f->symbolicPmfs();
+    StringVector result(pmfs.size());
+    for (size_t x = 0; x < pmfs.size(); ++x)
+        result[x] = Finitization::pdfToString(pmfs[x], format == 1);
+    return result;
 }
 
  //' Compute the probability mass function of a finitized distribution
@@ -112,53 +210,124 @@ StringVector c_printDensity(int n, IntegerVector val, Rcpp::List const &params,
  //'
  // [[Rcpp::export]]
 NumericVector c_d(int n, IntegerVector val, Rcpp::List const &params, int dtype) {
-    Finitization* f = nullptr;
     NumericVector result(val.size());
-    double theta, N, p, k, q;
-    switch(dtype) {
-    case DistributionType::POISSON:
-        if(params.containsElementNamed("theta")) {
-            theta = Rcpp::as < double >( params["theta"]);
-            f = new FinitizedPoissonDistribution(n, theta);
-        }
-        break;
-    case DistributionType::LOGARITHMIC:
-        if(params.containsElementNamed("theta")) {
-            theta = Rcpp::as < double >( params["theta"]);
-            f = new FinitizedLogarithmicDistribution(n, theta);
-        }
-        break;
-    case DistributionType::BINOMIAL:
-        if(params.containsElementNamed("N") && params.containsElementNamed("p")) {
-            N = Rcpp::as < int >( params["N"]);
-            p = Rcpp::as < double >( params["p"]);
-            f = new FinitizedBinomialDistribution(n, p, N);
-        }
-        else
-            Rcerr << "Binomial distribution parameter(s) not provided!" << endl;
-        break;
-    case DistributionType::NEGATIVEBINOMIAL:
-        if(params.containsElementNamed("k") && params.containsElementNamed("q")) {
-            k = Rcpp::as < int >( params["k"]);
-            q = Rcpp::as < double >( params["q"]);
-            f = new FinitizedNegativeBinomialDistribution(n, q, k);
-        }
-        else
-            Rcerr << "Negative Binomial distribution parameter(s) not provided!" << endl;
-        break;
-    default:
-        Rcerr << " Distribution type unsupported!" << endl;
-    }
+    DistributionKey key;
 
-    if(f) {
+    if(getDistributionKey(n, params, dtype, false, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
         for(int i = 0; i< val.size(); ++i)
             result[i] = f->fin_pdf(val[i]);
-        delete f;
     }
 
     return result;
 }
 
+ //' Compute the CDF of a finitized distribution
+ //'
+ //' This function returns the cumulative probabilities of a finitized distribution at the given values,
+ //' read from the compensated lower and upper tail sums kept by the cached distribution object.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param val An integer vector of values at which the CDF is computed.
+ //' @param params A named list of distribution-specific parameters (see \code{c_d}).
+ //' @param dtype An integer code identifying the distribution type.
+ //' @param lower_tail Logical; if \code{TRUE}, \eqn{P(X \le x)} is returned, otherwise \eqn{P(X > x)}.
+ //' @param log_p Logical; if \code{TRUE}, the logarithms of the probabilities are returned.
+ //'
+ //' @return A \code{NumericVector} with the cumulative probabilities.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_p(n = 4, val = 0:4, params = list(theta = 0.5), dtype = getPoissonType())
+ //'
+ // [[Rcpp::export]]
+NumericVector c_p(int n, IntegerVector val, Rcpp::List const &params, int dtype, bool lower_tail = true,
+                  bool log_p = false) {
+    NumericVector result(val.size(), NA_REAL);
+    DistributionKey key;
+
+    if(getDistributionKey(n, params, dtype, false, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+        for(int i = 0; i < val.size(); ++i)
+            if (val[i] != NA_INTEGER)
+                result[i] = f->cdf(val[i], lower_tail, log_p);
+    }
+
+    return result;
+}
+
+ //' Compute the quantiles of a finitized distribution
+ //'
+ //' This function returns, for each probability, the smallest value whose cumulative probability is at least
+ //' that probability. The quantiles are found by binary search in the CDF kept by the cached distribution object,
+ //' in a single pass over \code{p}.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param p A numeric vector of probabilities (log-probabilities if \code{log_p} is \code{TRUE}).
+ //' @param params A named list of distribution-specific parameters (see \code{c_d}).
+ //' @param dtype An integer code identifying the distribution type.
+ //' @param lower_tail Logical; if \code{TRUE}, the probabilities are \eqn{P(X \le x)}, otherwise \eqn{P(X > x)}.
+ //' @param log_p Logical; if \code{TRUE}, the probabilities are given on the log scale.
+ //'
+ //' @return An \code{IntegerVector} with the quantiles; \code{NA} for \code{NA} probabilities.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_q(n = 4, p = c(0.1, 0.5, 0.9), params = list(theta = 0.5), dtype = getPoissonType())
+ //'
+ // [[Rcpp::export]]
+IntegerVector c_q(int n, NumericVector p, Rcpp::List const &params, int dtype, bool lower_tail = true,
+                  bool log_p = false) {
+    IntegerVector result(p.size(), NA_INTEGER);
+    DistributionKey key;
+
+    if(getDistributionKey(n, params, dtype, false, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+        for(int i = 0; i < p.size(); ++i)
+            result[i] = f->quantile(p[i], lower_tail, log_p);
+    }
+
+    return result;
+}
+
+ //' Compute the PMF or CDF of a finitized distribution for many parameter values
+ //'
+ //' This function evaluates the finitized probability mass function (or the cumulative
+ //' distribution function) of one distribution family over a vector of parameter values
+ //' in a single native call. The symbolic work is shared by all the parameter values with
+ //' the same structural parameter (N or k) and the output matrix is filled column by column.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param theta A numeric vector with the values of the parameter (theta, p or q).
+ //' @param size An integer vector with the values of N (Binomial) or k (Negative Binomial),
+ //'   of length 1 or \code{length(theta)}. It is ignored for the Poisson and Logarithmic distributions.
+ //' @param dtype An integer code identifying the distribution type.
+ //'   Use helpers like \code{getPoissonType()}, \code{getBinomialType()}, etc.
+ //' @param cdf Logical; if \code{TRUE}, the cumulative probabilities are returned.
+ //' @param nthreads The number of worker threads used for the numeric evaluation;
+ //'   a value <= 0 uses all the hardware threads.
+ //'
+ //' @return A \code{NumericMatrix} with \code{n + 1} rows and \code{length(theta)} columns;
+ //'   column j contains the PMF (or CDF) for x = 0, ..., n and the parameter \code{theta[j]}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_dBatch(n = 3, theta = c(0.1, 0.2, 0.3), size = 4L, dtype = getBinomialType())
+ //'
+ // [[Rcpp::export]]
+NumericMatrix c_dBatch(int n, NumericVector theta, IntegerVector size, int dtype, bool cdf = false, int nthreads = 1) {
+    const int m = theta.size();
+    if(size.size() != 1 && size.size() != m)
+        stop("'size' must have length 1 or the same length as 'theta'.");
+
+    NumericMatrix result(n + 1, m);
+    if(m == 0)
+        return result;
+    if(!evaluateBatch(dtype, n, theta.begin(), size.begin(), size.size(), m, cdf, nthreads, result.begin()))
+        Rcerr << " Distribution type unsupported!" << endl;
+    return result;
+}
+
 
  //' Generate random values from a finitized distribution
  //'
@@ -175,6 +344,9 @@ NumericVector c_d(int n, IntegerVector val, Rcpp::List const &params, int dtype)
  //' @param dtype An integer code specifying the distribution type.
  //'   Use helper functions like \code{getPoissonType()}, \code{getBinomialType()}, etc.
  //' @param no An integer specifying how many random values to generate.
+ //' @param nthreads The number of threads. With 1 the values are drawn with R's uniform generator; any other value
+ //'   uses independent xoshiro256++ streams seeded from R's generator (0 uses all the hardware threads).
+ //' @param sampler The sampling method: 0 (auto), 1 (alias), 2 (ladder) or 3 (inversion).
  //'
  //' @return An \code{IntegerVector} of length \code{no} containing the generated random values.
  //' @keywords internal
@@ -184,50 +356,586 @@ NumericVector c_d(int n, IntegerVector val, Rcpp::List const &params, int dtype)
  //' rvalues(n = 3, params = list(N = 10, p = 0.4), no = 10, dtype = getBinomialType())
  //'
  // [[Rcpp::export]]
-IntegerVector rvalues(int n, Rcpp::List const &params, int no, int dtype) {
-    Finitization* f = nullptr;
+IntegerVector rvalues(int n, Rcpp::List const &params, int no, int dtype, int nthreads = 1, int sampler = 0) {
     IntegerVector result(no);
-    double theta, N, p, k, q;
-    switch(dtype) {
-    case DistributionType::POISSON:
-        if(params.containsElementNamed("theta")) {
-            theta = Rcpp::as < double >( params["theta"]);
-            f = new FinitizedPoissonDistribution(n, theta);
-        }
-        break;
-    case DistributionType::LOGARITHMIC:
-        if(params.containsElementNamed("theta")) {
-            theta = Rcpp::as < double >( params["theta"]);
-            f = new FinitizedLogarithmicDistribution(n, theta);
-        }
-        break;
-    case DistributionType::BINOMIAL:
-        if(params.containsElementNamed("N") && params.containsElementNamed("p")) {
-            N = Rcpp::as < int >( params["N"]);
-            p = Rcpp::as < double >( params["p"]);
-            f = new FinitizedBinomialDistribution(n, p, N);
-        }
-        else
-            Rcerr << "Binomial distribution parameter(s) not provided!" << endl;
+    DistributionKey key;
+
+    if(getDistributionKey(n, params, dtype, false, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+        result = (nthreads == 1) ? f->rvalues(no, sampler) : f->rvalues(no, nthreads, sampler);
+    }
+    return result;
+}
+
+// Restores a stream saved by streamState(), or starts a new one seeded from R's RNG if state is NULL.
+static ValueStream streamFromState(Nullable<CharacterVector> state) {
+    if (state.isNull())
+        return Finitization::newStream();
+    CharacterVector words(state.get());
+    if (words.size() != ValueStream::WORDS)
+        stop("Invalid stream state: %d words expected.", ValueStream::WORDS);
+    uint64_t w[ValueStream::WORDS];
+    for (int i = 0; i < ValueStream::WORDS; ++i) {
+        const std::string word = Rcpp::as<std::string>(words[i]);
+        char* end = nullptr;
+        w[i] = std::strtoull(word.c_str(), &end, 16);
+        if (word.empty() || *end != '\0')
+            stop("Invalid stream state word: %s.", word);
+    }
+    // A generator never reaches the all-zero state, and a block never has more than BLOCK values left
+    if ((w[0] | w[1] | w[2] | w[3]) == 0 || (w[4] | w[5] | w[6] | w[7]) == 0)
+        stop("Invalid stream state: the generator state is zero.");
+    if (w[8] > static_cast<uint64_t>(ValueStream::BLOCK))
+        stop("Invalid stream state: more than %d values left in the block.", ValueStream::BLOCK);
+    return ValueStream(w);
+}
+
+// The state of a stream as hexadecimal words, which are portable across platforms and R sessions.
+static CharacterVector streamState(const ValueStream& stream) {
+    uint64_t w[ValueStream::WORDS];
+    stream.save(w);
+    CharacterVector words(ValueStream::WORDS);
+    for (int i = 0; i < ValueStream::WORDS; ++i) {
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(w[i]));
+        words[i] = buf;
+    }
+    return words;
+}
+
+ //' Generate the next chunk of a stream of random values from a finitized distribution
+ //'
+ //' The values continue the stream described by \code{state} and are the same for any
+ //' split of the stream into chunks and any number of threads.
+ //'
+ //' @param n An integer specifying the finitization order.
+ //' @param params A named list of distribution parameters (see \code{rvalues}).
+ //' @param dtype An integer code specifying the distribution type.
+ //' @param no The number of values to generate.
+ //' @param state The state returned with the previous chunk, or \code{NULL} to start a stream
+ //'   seeded from R's generator.
+ //' @param nthreads The number of threads (0 uses all the hardware threads).
+ //' @param sampler The sampling method: 0 (auto), 1 (alias), 2 (ladder) or 3 (inversion).
+ //'
+ //' @return An \code{IntegerVector} of length \code{no} with the attribute \code{state}, the
+ //'   state of the stream after the chunk.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' x <- c_rstream(n = 3, params = list(theta = 0.5), dtype = getPoissonType(), no = 10,
+ //'                state = NULL, nthreads = 1, sampler = 0)
+ //' attr(x, "state")
+ //'
+ // [[Rcpp::export]]
+IntegerVector c_rstream(int n, Rcpp::List const &params, int dtype, int no, Nullable<CharacterVector> state,
+                        int nthreads = 1, int sampler = 0) {
+    if (no < 0)
+        stop("'no' must be nonnegative.");
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, false, key))
+        return IntegerVector(0);
+
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    ValueStream stream = streamFromState(state);
+    IntegerVector result(no);
+    f->stream(stream, result.begin(), no, nthreads, sampler);
+    result.attr("state") = streamState(stream);
+    return result;
+}
+
+ //' Write a stream of random values from a finitized distribution to a binary file
+ //'
+ //' The values are written as 32-bit integers in the native byte order, one memory-mapped
+ //' window of \code{chunk} values at a time, directly from the sampler to the file.
+ //'
+ //' @param n An integer specifying the finitization order.
+ //' @param params A named list of distribution parameters (see \code{rvalues}).
+ //' @param dtype An integer code specifying the distribution type.
+ //' @param no The number of values to write (may exceed the range of an integer).
+ //' @param file The name of the file.
+ //' @param state The state of the stream, or \code{NULL} to start a stream seeded from R's generator.
+ //' @param append If \code{TRUE} the values are added at the end of the file, otherwise the file is truncated.
+ //' @param chunk The number of values per mapped window.
+ //' @param nthreads The number of threads (0 uses all the hardware threads).
+ //' @param sampler The sampling method: 0 (auto), 1 (alias), 2 (ladder) or 3 (inversion).
+ //'
+ //' @return The state of the stream after the last value written.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' f <- tempfile()
+ //' c_rstreamToFile(n = 3, params = list(theta = 0.5), dtype = getPoissonType(), no = 1000, file = f,
+ //'                 state = NULL, append = FALSE, chunk = 256, nthreads = 1, sampler = 0)
+ //' unlink(f)
+ //'
+ // [[Rcpp::export]]
+CharacterVector c_rstreamToFile(int n, Rcpp::List const &params, int dtype, double no, std::string file,
+                                Nullable<CharacterVector> state, bool append = false, double chunk = 1048576,
+                                int nthreads = 1, int sampler = 0) {
+    if (!(no >= 0))
+        stop("'no' must be nonnegative.");
+    if (!(chunk >= 1) || chunk > 268435456.0)
+        stop("'chunk' must be between 1 and 2^28.");
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, false, key))
+        return CharacterVector(0);
+
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    ValueStream stream = streamFromState(state);
+
+    MappedFile out(file, append);
+    if (out.size() % sizeof(int) != 0)
+        stop("The size of %s is not a multiple of %d bytes.", file, (int)sizeof(int));
+    const uint64_t total = static_cast<uint64_t>(no);
+    const std::size_t window = static_cast<std::size_t>(chunk);
+    uint64_t offset = out.size();
+    for (uint64_t done = 0; done < total; ) {
+        checkUserInterrupt();
+        const std::size_t count = static_cast<std::size_t>(std::min<uint64_t>(window, total - done));
+        int* values = reinterpret_cast<int*>(out.map(offset, count * sizeof(int)));
+        f->stream(stream, values, count, nthreads, sampler);
+        done += count;
+        offset += count * sizeof(int);
+    }
+    out.unmap();
+    return streamState(stream);
+}
+
+ //' Build a bank of alias tables for many finitized distributions
+ //'
+ //' @param n The finitization orders, one per distribution.
+ //' @param theta The parameters (theta, p or q), one per distribution.
+ //' @param size The sizes (N or k, 0 for the one-parameter distributions), one per distribution.
+ //' @param dtype An integer code specifying the distribution type.
+ //'
+ //' @return An external pointer to the bank.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' bank <- c_samplerBank(c(3L, 3L), c(0.2, 0.4), c(0L, 0L), getPoissonType())
+ //'
+ // [[Rcpp::export]]
+SEXP c_samplerBank(IntegerVector n, NumericVector theta, IntegerVector size, int dtype) {
+    if (theta.size() != n.size() || size.size() != n.size())
+        stop("'n', 'theta' and 'size' must have the same length.");
+    std::vector<DistributionKey> keys;
+    keys.reserve(n.size());
+    for (int d = 0; d < n.size(); ++d)
+        keys.push_back(DistributionKey(dtype, n[d], theta[d], size[d]));
+    return XPtr<SamplerBank>(new SamplerBank(keys), true);
+}
+
+// The bank behind an external pointer; a pointer restored from a saved session is NULL.
+static SamplerBank& samplerBank(SEXP bank) {
+    XPtr<SamplerBank> ptr(bank);
+    if (!ptr.get())
+        stop("The sampler bank is no longer valid (e.g. it was restored from a saved session); build it again.");
+    return *ptr;
+}
+
+ //' Draw one value from each distribution of a bank designated by an index vector
+ //'
+ //' @param bank An external pointer returned by \code{c_samplerBank}.
+ //' @param index The distributions of the draws, 1-based.
+ //' @param state The state of the stream of random values, or \code{NULL} to start a stream
+ //'   seeded from R's generator.
+ //' @param nthreads The number of threads (0 uses all the hardware threads).
+ //'
+ //' @return An \code{IntegerVector} with the draws and the attribute \code{state}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' bank <- c_samplerBank(c(3L, 3L), c(0.2, 0.4), c(0L, 0L), getPoissonType())
+ //' c_rbank(bank, c(1L, 2L, 2L), NULL, 1L)
+ //'
+ // [[Rcpp::export]]
+IntegerVector c_rbank(SEXP bank, IntegerVector index, Nullable<CharacterVector> state, int nthreads = 1) {
+    const SamplerBank& b = samplerBank(bank);
+    std::vector<int> zeroBased(index.begin(), index.end());
+    for (std::size_t i = 0; i < zeroBased.size(); ++i)
+        zeroBased[i] = (zeroBased[i] == NA_INTEGER) ? -1 : zeroBased[i] - 1;
+
+    ValueStream stream = streamFromState(state);
+    IntegerVector result(index.size());
+    b.sample(stream, zeroBased.data(), zeroBased.size(), nthreads, result.begin());
+    result.attr("state") = streamState(stream);
+    return result;
+}
+
+ //' Size of a bank of alias tables
+ //'
+ //' @param bank An external pointer returned by \code{c_samplerBank}.
+ //'
+ //' @return A named list with the elements \code{size} (number of distributions) and
+ //'   \code{bytes} (memory used by the tables).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_bankInfo(c_samplerBank(3L, 0.2, 0L, getPoissonType()))
+ //'
+ // [[Rcpp::export]]
+List c_bankInfo(SEXP bank) {
+    const SamplerBank& b = samplerBank(bank);
+    return List::create(Named("size") = b.size(), Named("bytes") = (double)b.bytes());
+}
+
+ //' Build a finitized distribution kept alive by an external pointer
+ //'
+ //' The distribution is taken from (or added to) the cache of finitized distributions, and the
+ //' pointer keeps it alive after it is evicted from the cache. It is released by the finalizer of
+ //' the pointer.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param params A named list of distribution-specific parameters (see \code{c_d}).
+ //' @param dtype An integer code identifying the distribution type.
+ //'
+ //' @return An external pointer to the distribution, or \code{NULL} if the parameters are invalid.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' d <- c_distribution(n = 4, params = list(theta = 0.5), dtype = getPoissonType())
+ //'
+ // [[Rcpp::export]]
+SEXP c_distribution(int n, Rcpp::List const &params, int dtype) {
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, false, key))
+        return R_NilValue;
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    if (!f)
+        return R_NilValue;
+    return XPtr< std::shared_ptr<Finitization> >(new std::shared_ptr<Finitization>(f), true);
+}
+
+// The distribution behind an external pointer; a pointer restored from a saved session is NULL.
+static Finitization& distribution(SEXP handle) {
+    XPtr< std::shared_ptr<Finitization> > ptr(handle);
+    if (!ptr.get())
+        stop("The distribution is no longer valid (e.g. it was restored from a saved session); build it again.");
+    return **ptr;
+}
+
+ //' Compute the PMF of a finitized distribution given by an external pointer
+ //'
+ //' @param handle An external pointer returned by \code{c_distribution}.
+ //' @param val An integer vector of values.
+ //'
+ //' @return A \code{NumericVector} with the probabilities; \code{NA} for \code{NA} values.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_distD(c_distribution(4, list(theta = 0.5), getPoissonType()), 0:4)
+ //'
+ // [[Rcpp::export]]
+NumericVector c_distD(SEXP handle, IntegerVector val) {
+    Finitization& f = distribution(handle);
+    NumericVector result(val.size(), NA_REAL);
+    for(int i = 0; i < val.size(); ++i)
+        if (val[i] != NA_INTEGER)
+            result[i] = f.fin_pdf(val[i]);
+    return result;
+}
+
+ //' Compute the CDF of a finitized distribution given by an external pointer
+ //'
+ //' @param handle An external pointer returned by \code{c_distribution}.
+ //' @param val An integer vector of values.
+ //' @param lower_tail Logical; if \code{TRUE}, \eqn{P(X \le x)} is returned, otherwise \eqn{P(X > x)}.
+ //' @param log_p Logical; if \code{TRUE}, the logarithms of the probabilities are returned.
+ //'
+ //' @return A \code{NumericVector} with the cumulative probabilities.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_distP(c_distribution(4, list(theta = 0.5), getPoissonType()), 0:4)
+ //'
+ // [[Rcpp::export]]
+NumericVector c_distP(SEXP handle, IntegerVector val, bool lower_tail = true, bool log_p = false) {
+    const Finitization& f = distribution(handle);
+    NumericVector result(val.size(), NA_REAL);
+    for(int i = 0; i < val.size(); ++i)
+        if (val[i] != NA_INTEGER)
+            result[i] = f.cdf(val[i], lower_tail, log_p);
+    return result;
+}
+
+ //' Compute the quantiles of a finitized distribution given by an external pointer
+ //'
+ //' @param handle An external pointer returned by \code{c_distribution}.
+ //' @param p A numeric vector of probabilities (log-probabilities if \code{log_p} is \code{TRUE}).
+ //' @param lower_tail Logical; if \code{TRUE}, the probabilities are \eqn{P(X \le x)}, otherwise \eqn{P(X > x)}.
+ //' @param log_p Logical; if \code{TRUE}, the probabilities are given on the log scale.
+ //'
+ //' @return An \code{IntegerVector} with the quantiles; \code{NA} for \code{NA} probabilities.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_distQ(c_distribution(4, list(theta = 0.5), getPoissonType()), c(0.1, 0.5, 0.9))
+ //'
+ // [[Rcpp::export]]
+IntegerVector c_distQ(SEXP handle, NumericVector p, bool lower_tail = true, bool log_p = false) {
+    const Finitization& f = distribution(handle);
+    IntegerVector result(p.size(), NA_INTEGER);
+    for(int i = 0; i < p.size(); ++i)
+        result[i] = f.quantile(p[i], lower_tail, log_p);
+    return result;
+}
+
+ //' Generate random values from a finitized distribution given by an external pointer
+ //'
+ //' @param handle An external pointer returned by \code{c_distribution}.
+ //' @param no The number of values to generate.
+ //' @param nthreads The number of threads (see \code{rvalues}).
+ //' @param sampler The sampling method (see \code{rvalues}).
+ //'
+ //' @return An \code{IntegerVector} of length \code{no}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_distR(c_distribution(4, list(theta = 0.5), getPoissonType()), 10)
+ //'
+ // [[Rcpp::export]]
+IntegerVector c_distR(SEXP handle, int no, int nthreads = 1, int sampler = 0) {
+    Finitization& f = distribution(handle);
+    return (nthreads == 1) ? f.rvalues(no, sampler) : f.rvalues(no, nthreads, sampler);
+}
+
+ //' Symbolic PMF of a finitized distribution given by an external pointer
+ //'
+ //' @param handle An external pointer returned by \code{c_distribution}.
+ //' @param val An integer vector of values.
+ //' @param latex Logical; if \code{TRUE}, the strings are formatted in LaTeX.
+ //'
+ //' @return A \code{StringVector} with the PMF at each value, as a function of the parameter.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_distDensity(c_distribution(2, list(N = 4, p = 0.2), getBinomialType()), 0:2)
+ //'
+ // [[Rcpp::export]]
+StringVector c_distDensity(SEXP handle, IntegerVector val, bool latex = false) {
+    Finitization& f = distribution(handle);
+    StringVector result(val.size());
+    for(int i = 0; i < val.size(); ++i)
+        result[i] = f.pdfToString(val[i], latex);
+    return result;
+}
+
+ //' Fit a finitized distribution to a histogram of counts
+ //'
+ //' The method of moments estimate is computed first and, for the maximum likelihood method, used as the
+ //' starting value of a Newton iteration safeguarded by bisection in \code{[lower, upper]}. The log-likelihood
+ //' and its derivatives are evaluated from the compiled symbolic PMF and its derivatives.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param params A named list with the structural parameter: \code{list(N = trials)} (Binomial),
+ //'   \code{list(k = dispersion)} (Negative Binomial), an empty list otherwise.
+ //' @param dtype An integer code identifying the distribution type.
+ //' @param counts The counts of the values \code{0, ..., n}.
+ //' @param lower The lower limit of the parameter (the lower bound of the MFPS).
+ //' @param upper The upper limit of the parameter (the upper bound of the MFPS).
+ //' @param method 0 (maximum likelihood) or 1 (method of moments).
+ //'
+ //' @return A list with the elements \code{theta} (the estimate), \code{loglik}, \code{score} and
+ //'   \code{hessian} (the log-likelihood and its first two derivatives at the estimate) and
+ //'   \code{iterations}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_fit(n = 4, params = list(), dtype = getPoissonType(), counts = c(60, 30, 8, 1, 1), lower = 0, upper = 1)
+ //'
+ // [[Rcpp::export]]
+List c_fit(int n, Rcpp::List const &params, int dtype, NumericVector counts, double lower, double upper,
+           int method = 0) {
+    if (counts.size() != n + 1)
+        stop("'counts' must have n + 1 elements.");
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, true, key))
+        return List();
+
+    double total = 0.0, sum = 0.0;
+    for (int x = 0; x <= n; ++x) {
+        total += counts[x];
+        sum += x * counts[x];
+    }
+    double theta = LikelihoodFitter::momentEstimate(dtype, key.size, sum / total);
+    theta = std::min(std::max(theta, lower), upper);
+
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    const LikelihoodFitter fitter(*f);
+    int iterations = 0;
+    if (method == 0)
+        theta = fitter.maximize(counts.begin(), lower, upper, theta, iterations);
+
+    double loglik, score, hessian;
+    fitter.evaluate(counts.begin(), theta, loglik, score, hessian);
+    return List::create(Named("theta") = theta, Named("loglik") = loglik, Named("score") = score,
+                        Named("hessian") = hessian, Named("iterations") = iterations);
+}
+
+ // The counts of 0, ..., n of a histogram, with the number of values outside as an attribute
+static NumericVector histogramCounts(const Histogram& h) {
+    NumericVector result(h.order() + 1);
+    for (int x = 0; x <= h.order(); ++x)
+        result[x] = static_cast<double>(h.count(x));
+    result.attr("outside") = static_cast<double>(h.outside());
+    return result;
+}
+
+ //' Count the values 0, ..., n of a vector
+ //'
+ //' @param x An integer or numeric vector.
+ //' @param n The largest value counted.
+ //' @param nthreads The number of threads (0 uses all the hardware threads).
+ //'
+ //' @return A \code{NumericVector} with the counts of \code{0, ..., n}; its attribute \code{outside} is the number
+ //'   of the other values (\code{NA} included).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_histogram(c(0L, 1L, 1L, 3L, 7L), 3)
+ //'
+ // [[Rcpp::export]]
+NumericVector c_histogram(SEXP x, int n, int nthreads = 1) {
+    Histogram h(n);
+    const std::size_t size = static_cast<std::size_t>(XLENGTH(x));
+    switch(TYPEOF(x)) {
+    case INTSXP:
+        h.add(INTEGER(x), size, nthreads);
         break;
-    case DistributionType::NEGATIVEBINOMIAL:
-        if(params.containsElementNamed("k") && params.containsElementNamed("q")) {
-            k = Rcpp::as < int >( params["k"]);
-            q = Rcpp::as < double >( params["q"]);
-            f = new FinitizedNegativeBinomialDistribution(n, q, k);
-        }
-        else
-            Rcerr << "Negative Binomial distribution parameter(s) not provided!" << endl;
+    case REALSXP:
+        h.add(REAL(x), size, nthreads);
         break;
     default:
-        Rcerr << " Distribution type unsupported!" << endl;
+        stop("'x' must be an integer or numeric vector.");
+    }
+    return histogramCounts(h);
+}
+
+ //' Count the values 0, ..., n of a file
+ //'
+ //' @param file The name of the file.
+ //' @param n The largest value counted.
+ //' @param binary If \code{TRUE} the file holds 32-bit integers in the native byte order (as written by
+ //'   \code{c_rstreamToFile}) and is memory-mapped, otherwise it is a text file of integers separated by blanks,
+ //'   commas or line ends.
+ //' @param chunk The number of values per mapped window (binary file) or of bytes per read (text file).
+ //' @param nthreads The number of threads (0 uses all the hardware threads).
+ //'
+ //' @return A \code{NumericVector} with the counts, as \code{c_histogram}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' f <- tempfile()
+ //' writeLines(c("0 1 1", "3 7"), f)
+ //' c_histogramFile(f, 3, binary = FALSE)
+ //' unlink(f)
+ //'
+ // [[Rcpp::export]]
+NumericVector c_histogramFile(std::string file, int n, bool binary = true, double chunk = 1048576,
+                              int nthreads = 1) {
+    if (!(chunk >= 1) || chunk > 268435456.0)
+        stop("'chunk' must be between 1 and 2^28.");
+    Histogram h(n);
+    if (binary)
+        h.addBinaryFile(file, static_cast<std::size_t>(chunk), nthreads);
+    else
+        h.addTextFile(file, static_cast<std::size_t>(chunk), nthreads);
+    return histogramCounts(h);
+}
+
+ //' Compute the log-likelihood of a histogram
+ //'
+ //' @param n An integer specifying the finitization order.
+ //' @param params A named list of distribution parameters (see \code{rvalues}).
+ //' @param dtype An integer code specifying the distribution type.
+ //' @param counts The counts of the values \code{0, ..., n}.
+ //'
+ //' @return The sum of \code{counts[x + 1] * log(pdf(x))}, \code{-Inf} if a value with a positive count has
+ //'   probability 0.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_loglik(n = 4, params = list(theta = 0.5), dtype = getPoissonType(), counts = c(60, 30, 8, 1, 1))
+ //'
+ // [[Rcpp::export]]
+double c_loglik(int n, Rcpp::List const &params, int dtype, NumericVector counts) {
+    if (counts.size() != n + 1)
+        stop("'counts' must have n + 1 elements.");
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, false, key))
+        return NA_REAL;
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    double loglik = 0.0;
+    for (int x = 0; x <= n; ++x)
+        if (counts[x] > 0)
+            loglik += counts[x] * std::log(f->fin_pdf(x));
+    return loglik;
+}
+
+ //' Goodness of fit test of a histogram for a finitized distribution
+ //'
+ //' @param n An integer specifying the finitization order.
+ //' @param params A named list of distribution parameters (see \code{rvalues}).
+ //' @param dtype An integer code specifying the distribution type.
+ //' @param counts The counts of the values \code{0, ..., n}.
+ //' @param test The statistic: 0 (chi-square), 1 (G) or 2 (Kolmogorov).
+ //' @param estimated The number of parameters estimated from the sample, subtracted from the degrees of freedom.
+ //'   It must be 0 with \code{B > 0} or the Kolmogorov statistic.
+ //' @param B The number of Monte Carlo replicates; 0 computes the asymptotic p-value.
+ //' @param nthreads The number of threads used by the replicates (0 uses all the hardware threads).
+ //'
+ //' @return A list with the elements \code{statistic}, \code{parameter} (the degrees of freedom of the chi-square
+ //'   and G statistics, \code{NA} otherwise or with \code{B > 0}), \code{p_value} and \code{expected} (the expected
+ //'   counts).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_gof(n = 4, params = list(theta = 0.5), dtype = getPoissonType(), counts = c(60, 30, 8, 1, 1), test = 0)
+ //'
+ // [[Rcpp::export]]
+List c_gof(int n, Rcpp::List const &params, int dtype, NumericVector counts, int test, int estimated = 0,
+           int B = 0, int nthreads = 1) {
+    if (counts.size() != n + 1)
+        stop("'counts' must have n + 1 elements.");
+    if (test < GofTest::CHI_SQUARE || test > GofTest::KOLMOGOROV)
+        stop("Unknown goodness of fit test %d.", test);
+    if (estimated > 0 && (B > 0 || test == GofTest::KOLMOGOROV))
+        stop("Estimated parameters are only accounted for by the asymptotic chi-square and G tests.");
+    DistributionKey key;
+    if(!getDistributionKey(n, params, dtype, false, key))
+        return List();
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+
+    NumericVector probs(n + 1);
+    double total = 0.0;
+    int support = 0;
+    for (int x = 0; x <= n; ++x) {
+        probs[x] = f->fin_pdf(x);
+        total += counts[x];
+        if (probs[x] > 0.0)
+            ++support;
     }
+    const GoodnessOfFit gof(test, probs.begin(), n);
+    const double statistic = gof.statistic(counts.begin());
 
-    if(f) {
-        result = f->rvalues(no);
-        delete f;
+    double parameter = NA_REAL, p_value;
+    if (B > 0) {
+        std::vector<double> cutoff(n + 1);
+        std::vector<int> alias(n + 1);
+        f->aliasTables(cutoff.data(), alias.data());
+        const int hits = gof.exceedances(cutoff.data(), alias.data(), static_cast<uint64_t>(total), statistic, B,
+                                         Finitization::newSeed(), nthreads);
+        p_value = (1.0 + hits) / (1.0 + B);
     }
-    return result;
+    else if (test == GofTest::KOLMOGOROV) {
+        p_value = GoodnessOfFit::kolmogorovPValue(statistic, total);
+    }
+    else {
+        parameter = support - 1 - estimated;
+        p_value = parameter > 0 ? R::pchisq(statistic, parameter, 0, 0) : NA_REAL;
+    }
+    return List::create(Named("statistic") = statistic, Named("parameter") = parameter,
+                        Named("p_value") = p_value, Named("expected") = probs * total);
 }
 
  //' Compute the symbolic expression for \code{pdf(n - 1)} used in MFPS bounds
@@ -249,44 +957,315 @@ IntegerVector rvalues(int n, Rcpp::List const &params, int no, int dtype) {
  //'
  // [[Rcpp::export]]
 String MFPS_pdf(int n, Rcpp::List const &params, int dtype ) {
-    Finitization* f = nullptr;
     String result;
-    double  N, k;
-    switch(dtype) {
-    case DistributionType::POISSON:
-        f = new FinitizedPoissonDistribution(n, 0.0);
-        break;
-    case DistributionType::LOGARITHMIC:
-        f = new FinitizedLogarithmicDistribution(n, 0.001);
-        break;
-    case DistributionType::BINOMIAL:
-        if(params.containsElementNamed("N") ) {
-            N = Rcpp::as < int >( params["N"]);
-            f = new FinitizedBinomialDistribution(n, 0.0, N);
-        }
-        else
-            Rcerr << "Binomial distribution parameter(s) not provided!" << endl;
-        break;
-    case DistributionType::NEGATIVEBINOMIAL:
-        if(params.containsElementNamed("k")) {
-            k = Rcpp::as < int >( params["k"]);
-            f = new FinitizedNegativeBinomialDistribution(n, 0.0, k);
-        }
-        else
-            Rcerr << "Negative Binomial distribution parameter(s) not provided!" << endl;
-        break;
-    default:
-        Rcerr << " Distribution type unsupported!" << endl;
-    }
+    DistributionKey key;
 
-    if(f) {
+    if(getDistributionKey(n, params, dtype, true, key)) {
+        std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
         result = f->pdfToString(n-1);
-        delete f;
     }
     return result;
 
 }
 
+ //' Compute the maximum feasible parameter space (MFPS) natively
+ //'
+ //' This function computes the MFPS bounds of a finitized distribution from the polynomial
+ //' \code{pdf(n - 1)}, without building an R expression: the real roots in [0, 1] are isolated
+ //' with a Sturm sequence and refined with Newton's method to a certified tolerance. The bounds
+ //' follow the same rules as \code{findSolutions}.
+ //'
+ //' @param n An integer greater than 0 specifying the finitization order.
+ //' @param params A named list of distribution-specific parameters. For example, use \code{list(N = 4)} for Binomial or \code{list(k = 3)} for Negative Binomial.
+ //' @param dtype An integer code representing the distribution type (e.g., Poisson, Binomial, Negative Binomial, Logarithmic).
+ //'
+ //' @return A numeric vector \code{c(LL, UL)} with the MFPS bounds, or an empty vector if \code{pdf(n - 1)}
+ //'   is not a polynomial in the parameter (Logarithmic distribution) or the symbolic engine is selected;
+ //'   the bounds must then be computed with \code{MFPS_pdf} and \code{findSolutions}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_mfps(n = 3, params = list(N = 5), dtype = getBinomialType())
+ //'
+ // [[Rcpp::export]]
+NumericVector c_mfps(int n, Rcpp::List const &params, int dtype) {
+    DistributionKey key;
+    if(Finitization::getEngine() == EvaluationEngine::SYMBOLIC || !getDistributionKey(n, params, dtype, true, key))
+        return NumericVector(0);
+
+    std::shared_ptr<Finitization> f = FinitizationCache::instance().get(key);
+    double lower, upper;
+    if(!MfpsSolver().solve(*f, lower, upper))
+        return NumericVector(0);
+    return NumericVector::create(lower, upper);
+}
+
+ //' Statistics of the cache of finitized distribution objects
+ //'
+ //' The exported entry points (\code{c_d}, \code{rvalues}, \code{c_printDensity},
+ //' \code{MFPS_pdf}) reuse finitized distribution objects stored in a bounded
+ //' least-recently-used cache keyed by distribution type, finitization order and
+ //' parameters. This function reports the state of that cache.
+ //'
+ //' @return A named list with the elements \code{size} (number of cached objects),
+ //'   \code{capacity} (maximum number of cached objects), \code{hits}, \code{misses}
+ //'   and \code{templates} (number of cached parameter-independent PMF templates).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_cacheStats()
+ //'
+ // [[Rcpp::export]]
+List c_cacheStats() {
+    FinitizationCache& cache = FinitizationCache::instance();
+    return List::create(Named("size") = (double)cache.size(),
+                        Named("capacity") = (double)cache.capacity(),
+                        Named("hits") = (double)cache.hits(),
+                        Named("misses") = (double)cache.misses(),
+                        Named("templates") = (double)cache.templates());
+}
+
+ //' Clear the cache of finitized distribution objects
+ //'
+ //' Drops all cached finitized distribution objects and PMF templates and resets
+ //' the hit/miss counters.
+ //'
+ //' @return No return value.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_clearCache()
+ //'
+ // [[Rcpp::export]]
+void c_clearCache() {
+    FinitizationCache::instance().clear();
+}
+
+ //' Set the capacity of the cache of finitized distribution objects
+ //'
+ //' @param capacity The maximum number of cached objects. A value of 0 disables caching.
+ //'
+ //' @return No return value.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_setCacheCapacity(256)
+ //'
+ // [[Rcpp::export]]
+void c_setCacheCapacity(int capacity) {
+    if(capacity < 0)
+        stop("'capacity' must be nonnegative.");
+    FinitizationCache::instance().setCapacity(capacity);
+}
+
+ //' Timers and counters of the computational phases
+ //'
+ //' @return A named list with the elements \code{name} (the phases, then the counters),
+ //'   \code{count} (number of runs of a phase, or the value of a counter) and
+ //'   \code{seconds} (time spent in a phase, \code{NA} for the counters).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_profile()
+ //'
+ // [[Rcpp::export]]
+List c_profile() {
+    const int rows = Instrumentation::PHASES + Instrumentation::COUNTERS;
+    CharacterVector name(rows);
+    NumericVector count(rows), seconds(rows);
+    for (int i = 0; i < Instrumentation::PHASES; ++i) {
+        name[i] = Instrumentation::phaseName(i);
+        count[i] = Instrumentation::calls(i);
+        seconds[i] = Instrumentation::seconds(i);
+    }
+    for (int i = 0; i < Instrumentation::COUNTERS; ++i) {
+        const int row = Instrumentation::PHASES + i;
+        name[row] = Instrumentation::counterName(i);
+        count[row] = Instrumentation::counter(i);
+        seconds[row] = NA_REAL;
+    }
+    return List::create(Named("name") = name, Named("count") = count, Named("seconds") = seconds);
+}
+
+ //' Reset the timers and counters of the computational phases
+ //'
+ //' @return No return value.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_resetProfile()
+ //'
+ // [[Rcpp::export]]
+void c_resetProfile() {
+    Instrumentation::reset();
+}
+
+ //' Enable or disable the timers and counters of the computational phases
+ //'
+ //' @param enabled Logical; TRUE to start recording, FALSE to stop.
+ //'
+ //' @return TRUE if recording is enabled after the call. It is always FALSE if the package
+ //'   was compiled with \code{FINITIZATION_INSTRUMENT=0}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_setProfiling(FALSE)
+ //'
+ // [[Rcpp::export]]
+bool c_setProfiling(bool enabled) {
+    Instrumentation::setEnabled(enabled);
+    return Instrumentation::enabled();
+}
+
+ //' Select the method used to compute the finitized probabilities
+ //'
+ //' @param engine The engine code: 0 (auto), 1 (series), 2 (template) or 3 (symbolic).
+ //'
+ //' @return The code of the previously selected engine.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_setEvaluationEngine(3)
+ //'
+ // [[Rcpp::export]]
+int c_setEvaluationEngine(int engine) {
+    const int previous = Finitization::getEngine();
+    Finitization::setEngine(engine);
+    // Cached objects hold probabilities computed with the previous engine
+    if (engine != previous)
+        FinitizationCache::instance().clear();
+    return previous;
+}
+
+ //' Return the method used to compute the finitized probabilities
+ //'
+ //' @return The engine code: 0 (auto), 1 (series), 2 (template) or 3 (symbolic).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_getEvaluationEngine()
+ //'
+ // [[Rcpp::export]]
+int c_getEvaluationEngine() {
+    return Finitization::getEngine();
+}
+
+ //' Select the arithmetic of the numeric evaluation of the finitized probabilities
+ //'
+ //' @param precision The precision code: 0 (double) or 1 (double-double).
+ //'
+ //' @return The code of the previously selected precision.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_setEvaluationPrecision(1)
+ //'
+ // [[Rcpp::export]]
+int c_setEvaluationPrecision(int precision) {
+    const int previous = Finitization::getPrecision();
+    Finitization::setPrecision(precision);
+    // Cached objects hold probabilities computed with the previous precision
+    if (precision != previous)
+        FinitizationCache::instance().clear();
+    return previous;
+}
+
+ //' Return the arithmetic of the numeric evaluation of the finitized probabilities
+ //'
+ //' @return The precision code: 0 (double) or 1 (double-double).
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_getEvaluationPrecision()
+ //'
+ // [[Rcpp::export]]
+int c_getEvaluationPrecision() {
+    return Finitization::getPrecision();
+}
+
+ //' Select the kernel used to turn uniforms into alias-method draws
+ //'
+ //' All the kernels give the same values for the same uniforms; a kernel not supported by the CPU is replaced
+ //' by the best supported one.
+ //'
+ //' @param kernel The kernel code: 0 (scalar), 1 (AVX2), 2 (AVX-512) or a negative value for the best one.
+ //'
+ //' @return The code of the previously selected kernel.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_setAliasKernel(0)
+ //'
+ // [[Rcpp::export]]
+int c_setAliasKernel(int kernel) {
+    return AliasKernel::select(kernel);
+}
+
+ //' Register a user-defined family of distributions
+ //'
+ //' @param name The name of the family.
+ //' @param pgf The probability generating function, an expression in \code{s} and \code{theta} read by the GiNaC
+ //'   parser.
+ //' @param constants A named list of numeric constants that may appear in \code{pgf}.
+ //'
+ //' @return The identifier of the family, passed as \code{family} in the parameters of the other functions
+ //'   with the distribution type \code{getCustomType()}.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_registerFamily("ztpois", "(exp(theta*s) - 1)/(exp(theta) - 1)", list())
+ //'
+ // [[Rcpp::export]]
+int c_registerFamily(std::string name, std::string pgf, Rcpp::List const &constants) {
+    std::map<std::string, double> values;
+    if (constants.size() > 0) {
+        CharacterVector names = constants.names();
+        for (int i = 0; i < constants.size(); ++i)
+            values[Rcpp::as<std::string>(names[i])] = Rcpp::as<double>(constants[i]);
+    }
+    return FamilyRegistry::instance().add(name, pgf, values);
+}
+
+ //' List the user-defined families of distributions
+ //'
+ //' @return A list with the elements \code{name}, \code{pgf} and \code{id}, one entry per registered name.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' c_families()
+ //'
+ // [[Rcpp::export]]
+List c_families() {
+    const FamilyRegistry& registry = FamilyRegistry::instance();
+    const std::vector<std::string> names = registry.names();
+    CharacterVector pgf(names.size());
+    IntegerVector id(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        id[i] = registry.find(names[i]);
+        pgf[i] = registry.pgf(id[i]);
+    }
+    return List::create(Named("name") = names, Named("pgf") = pgf, Named("id") = id);
+}
+
+ //' Return internal identifier for the user-defined families
+ //'
+ //' This helper function returns the internal integer constant used to
+ //' identify the distributions of the families registered with
+ //' \code{registerFinitizedFamily()}; the family itself is given by its
+ //' identifier in the distribution parameters.
+ //'
+ //' @return An integer code representing the user-defined families.
+ //' @keywords internal
+ //'
+ //' @examples
+ //' # Used internally to specify distribution type
+ //' getCustomType()
+ //'
+ // [[Rcpp::export]]
+ int getCustomType() {
+     return DistributionType::CUSTOM;
+ }
+
  //' Return internal identifier for the Poisson distribution
  //'
  //' This helper function returns the internal integer constant used to